@@ -20,18 +20,33 @@
 
 #include "IKRig_ConstraintBones.h"
 
+// Unreal Engine includes
+#include "Algo/StableSort.h"
+
+// TTToolbox includes
+#include "TTToolbox.h"
+
 #define LOCTEXT_NAMESPACE "UIKRig_BoneConstrainer"
 
+DECLARE_CYCLE_STAT(TEXT("Constraint Bones Solve"), STAT_TTConstraintBonesSolve, STATGROUP_TTToolbox);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Constraint Bones Applied"), STAT_TTConstraintBonesApplied, STATGROUP_TTToolbox);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Constraint Bones Dirty Ranges"), STAT_TTConstraintBonesDirtyRanges, STATGROUP_TTToolbox);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Constraint Bones Updated Bones"), STAT_TTConstraintBonesUpdated, STATGROUP_TTToolbox);
+
 UIKRig_ConstraintBones::UIKRig_ConstraintBones() {}
 UIKRig_ConstraintBones::~UIKRig_ConstraintBones() {}
 
 void UIKRig_ConstraintBones::Initialize(const FIKRigSkeleton& IKRigSkeleton)
 {
-	m_constraintBones.Reserve(ConstraintBones.Num());
+	m_constraintBones.Reset(ConstraintBones.Num());
+	m_dirtyRanges.Reset();
+	m_dirtyBones.Reset();
+	m_numDirtyBones = 0;
+	m_hasContiguousBranches = false;
+	m_canBatchPropagation = false;
 
 	bool errorsOccurred = false;
 
-	//! @todo @ffs sort bone indices
 	for (auto& constraint : ConstraintBones)
 	{
 		int32 constraintBone = IKRigSkeleton.GetBoneIndexFromName(constraint.ConstraintBone);
@@ -51,33 +66,286 @@ void UIKRig_ConstraintBones::Initialize(const FIKRigSkeleton& IKRigSkeleton)
 			continue;
 		}
 
-			m_constraintBones.Add(
-				{
-					constraintBone,
-					modifiedBone
-			});
+		CConstrainedBone constrainedBone;
+		constrainedBone.ConstraintBone = constraintBone;
+		constrainedBone.ModifiedBone = modifiedBone;
+		constrainedBone.Channels = 0;
+		constrainedBone.Channels |= constraint.Translation ? ChannelTranslation : 0;
+		constrainedBone.Channels |= constraint.Rotation ? ChannelRotation : 0;
+		constrainedBone.Channels |= constraint.Scale ? ChannelScale : 0;
+		constrainedBone.Alpha = FMath::Clamp(constraint.Alpha, 0.f, 1.f);
+		if (constraint.MaintainOffset)
+		{
+			constrainedBone.Offset = IKRigSkeleton.RefPoseGlobal[modifiedBone].GetRelativeTransform(IKRigSkeleton.RefPoseGlobal[constraintBone]);
+		}
+		constrainedBone.IsFullCopy = constrainedBone.Channels == ChannelsAll &&
+		                             constrainedBone.Alpha >= 1.f &&
+		                             !constraint.MaintainOffset;
+
+		if (constrainedBone.Channels == 0 || constrainedBone.Alpha <= 0.f)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Constraint of ModifiedBone %s does not affect any channel and will be ignored."), *constraint.ModifiedBone.ToString());
+			continue;
+		}
+
+		m_constraintBones.Add(constrainedBone);
 	}
 
 	if (errorsOccurred)
 	{
 		UE_LOG(LogTemp, Error, TEXT("Some constraint bones could not be set up, no constraining will be done. Please check the error messages above."));
 		m_constraintBones.Empty();
+		return;
+	}
+
+	// The bones of the IK rig skeleton are stored in hierarchy order (parents before children),
+	// so sorting by the modified bone index processes all constraints from the root to the leafs.
+	// The sort is stable to keep the configured order for constraints of the same bone.
+	Algo::StableSortBy(m_constraintBones, &CConstrainedBone::ModifiedBone);
+
+	// Constraints of the same modified bone are applied in the configured order, as they can affect different channels.
+	// Only earlier constraints with the same constraint bone and channels are removed, as they are overwritten anyway (last one wins).
+	for (int32 ii = m_constraintBones.Num() - 1; ii > 0; --ii)
+	{
+		for (int32 jj = ii - 1; jj >= 0 && m_constraintBones[jj].ModifiedBone == m_constraintBones[ii].ModifiedBone; --jj)
+		{
+			if (m_constraintBones[jj].ConstraintBone == m_constraintBones[ii].ConstraintBone && m_constraintBones[jj].Channels == m_constraintBones[ii].Channels)
+			{
+				m_constraintBones.RemoveAt(jj);
+				--ii;
+			}
+		}
+	}
+
+	// Nothing to precalculate without any constraint, e.g. for a newly added solver or if all constraints are ignored.
+	if (m_constraintBones.Num() <= 0)
+	{
+		return;
 	}
+
+	// Precalculate all bones affected by the constraints, which are the modified bones and all of their children.
+	// The bones are stored in hierarchy order (parents before children), so a single sweep propagates the flag.
+	const int32 numBones = IKRigSkeleton.BoneNames.Num();
+	m_dirtyBones.Init(false, numBones);
+	for (auto& constraintBone : m_constraintBones)
+	{
+		m_dirtyBones[constraintBone.ModifiedBone] = true;
+	}
+
+	for (int32 boneIndex = m_constraintBones[0].ModifiedBone + 1; boneIndex < numBones; ++boneIndex)
+	{
+		const int32 parentIndex = IKRigSkeleton.ParentIndices[boneIndex];
+		if (parentIndex != INDEX_NONE && m_dirtyBones[parentIndex])
+		{
+			m_dirtyBones[boneIndex] = true;
+		}
+	}
+	m_numDirtyBones = m_dirtyBones.CountSetBits();
+
+	// Precalculate the branch of each modified bone as contiguous range. This is only valid if the bones are stored depth first,
+	// then a bone belongs to the branch as long as its parent is part of the branch as well, which means its parent index
+	// is not smaller than the index of the modified bone. Nested branches are merged, so each bone is part of at most one dirty range.
+	// Otherwise the dirty bones are tested one by one during the solve.
+	m_hasContiguousBranches = isDepthFirstOrder(IKRigSkeleton.ParentIndices);
+	if (m_hasContiguousBranches)
+	{
+		for (auto& constraintBone : m_constraintBones)
+		{
+			int32 lastBranchBone = constraintBone.ModifiedBone;
+			while (lastBranchBone + 1 < numBones && IKRigSkeleton.ParentIndices[lastBranchBone + 1] >= constraintBone.ModifiedBone)
+			{
+				++lastBranchBone;
+			}
+
+			if (m_dirtyRanges.Num() > 0 && constraintBone.ModifiedBone <= m_dirtyRanges.Last().Last)
+			{
+				m_dirtyRanges.Last().Last = FMath::Max(m_dirtyRanges.Last().Last, lastBranchBone);
+			}
+			else
+			{
+				m_dirtyRanges.Add({ constraintBone.ModifiedBone, lastBranchBone });
+			}
+		}
+	}
+
+	// The batched solve sweeps once over the dirty bones. A constraint bone that is a dirty bone
+	// and comes after the modified bone it constraints would be read before it got updated. Those setups are solved
+	// sequentially like before.
+	m_canBatchPropagation = true;
+	for (auto& constraintBone : m_constraintBones)
+	{
+		if (constraintBone.ConstraintBone < constraintBone.ModifiedBone)
+		{
+			continue;
+		}
+
+		if (m_dirtyBones[constraintBone.ConstraintBone])
+		{
+			m_canBatchPropagation = false;
+			break;
+		}
+	}
+
+	if (BatchPropagation && !m_canBatchPropagation)
+	{
+		UE_LOG(LogTemp, Display, TEXT("At least one constraint bone depends on a bone modified by the same solver, falling back to sequential propagation."));
+	}
+
+	UE_LOG(LogTemp, Verbose, TEXT("Constraint bones dirty table: %i ranges covering %i of %i bones (contiguous branches: %s)."), m_dirtyRanges.Num(), m_numDirtyBones, numBones, m_hasContiguousBranches ? TEXT("true") : TEXT("false"));
 }
 
 void UIKRig_ConstraintBones::Solve(FIKRigSkeleton& IKRigSkeleton, const FIKRigGoalContainer& Goals)
 {
+	SCOPE_CYCLE_COUNTER(STAT_TTConstraintBonesSolve);
+
 	if (m_constraintBones.Num() <= 0)
 	{
 		// nothing to do here as no constraint bones are configured
 		return;
 	}
 
+	if (BatchPropagation && m_canBatchPropagation)
+	{
+		solveBatched(IKRigSkeleton);
+	}
+	else
+	{
+		solveSequential(IKRigSkeleton);
+	}
+}
+
+void UIKRig_ConstraintBones::solveSequential(FIKRigSkeleton& IKRigSkeleton)
+{
 	for (auto& constraintBone : m_constraintBones)
 	{
-		IKRigSkeleton.CurrentPoseGlobal[constraintBone.ModifiedBone] = IKRigSkeleton.CurrentPoseGlobal[constraintBone.ConstraintBone];
+		applyConstraint(IKRigSkeleton, constraintBone);
 		IKRigSkeleton.PropagateGlobalPoseBelowBone(constraintBone.ModifiedBone);
 	}
+
+	INC_DWORD_STAT_BY(STAT_TTConstraintBonesApplied, m_constraintBones.Num());
+}
+
+void UIKRig_ConstraintBones::solveBatched(FIKRigSkeleton& IKRigSkeleton)
+{
+	// Single sweep over the precalculated dirty bones: modified bones get their global transform from the constraint bone,
+	// all other dirty bones are below a modified bone and get their global transform recalculated from their (unchanged) local transform.
+	// As parents are always visited before their children, each affected bone is touched exactly once.
+	int32 constraintIndex = 0;
+	if (m_hasContiguousBranches)
+	{
+		for (auto& dirtyRange : m_dirtyRanges)
+		{
+			for (int32 boneIndex = dirtyRange.First; boneIndex <= dirtyRange.Last; ++boneIndex)
+			{
+				if (!applyConstraintsOfBone(IKRigSkeleton, boneIndex, boneIndex != dirtyRange.First, constraintIndex))
+				{
+					IKRigSkeleton.UpdateGlobalTransformFromLocal(boneIndex);
+				}
+			}
+		}
+	}
+	else
+	{
+		const int32 numBones = IKRigSkeleton.BoneNames.Num();
+		for (int32 boneIndex = m_constraintBones[0].ModifiedBone; boneIndex < numBones; ++boneIndex)
+		{
+			if (!m_dirtyBones[boneIndex])
+			{
+				continue;
+			}
+
+			const int32 parentIndex = IKRigSkeleton.ParentIndices[boneIndex];
+			const bool isParentDirty = parentIndex != INDEX_NONE && m_dirtyBones[parentIndex];
+			if (!applyConstraintsOfBone(IKRigSkeleton, boneIndex, isParentDirty, constraintIndex))
+			{
+				IKRigSkeleton.UpdateGlobalTransformFromLocal(boneIndex);
+			}
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_TTConstraintBonesApplied, m_constraintBones.Num());
+	INC_DWORD_STAT_BY(STAT_TTConstraintBonesDirtyRanges, m_dirtyRanges.Num());
+	INC_DWORD_STAT_BY(STAT_TTConstraintBonesUpdated, m_numDirtyBones);
+}
+
+bool UIKRig_ConstraintBones::applyConstraintsOfBone(FIKRigSkeleton& IKRigSkeleton, int32 BoneIndex, bool IsParentDirty, int32& ConstraintIndex) const
+{
+	if (ConstraintIndex >= m_constraintBones.Num() || m_constraintBones[ConstraintIndex].ModifiedBone != BoneIndex)
+	{
+		return false;
+	}
+
+	if (!m_constraintBones[ConstraintIndex].IsFullCopy && IsParentDirty)
+	{
+		// partial constraints blend with the current pose, which is outdated if a parent bone was modified
+		IKRigSkeleton.UpdateGlobalTransformFromLocal(BoneIndex);
+	}
+
+	// all constraints of the bone are applied in the configured order
+	while (ConstraintIndex < m_constraintBones.Num() && m_constraintBones[ConstraintIndex].ModifiedBone == BoneIndex)
+	{
+		applyConstraint(IKRigSkeleton, m_constraintBones[ConstraintIndex]);
+		++ConstraintIndex;
+	}
+	IKRigSkeleton.UpdateLocalTransformFromGlobal(BoneIndex);
+
+	return true;
+}
+
+bool UIKRig_ConstraintBones::isDepthFirstOrder(const TArray<int32>& ParentIndices)
+{
+	// The bones are depth first if each bone directly follows its parent or a descendant of its parent.
+	// The first 'numAncestors' entries of 'ancestors' hold the previous bone and all of its parents.
+	TArray<int32> ancestors;
+	ancestors.SetNumUninitialized(ParentIndices.Num());
+	int32 numAncestors = 0;
+	for (int32 boneIndex = 0; boneIndex < ParentIndices.Num(); ++boneIndex)
+	{
+		const int32 parentIndex = ParentIndices[boneIndex];
+		while (numAncestors > 0 && ancestors[numAncestors - 1] != parentIndex)
+		{
+			--numAncestors;
+		}
+
+		if (parentIndex != INDEX_NONE && numAncestors == 0)
+		{
+			return false;
+		}
+
+		ancestors[numAncestors++] = boneIndex;
+	}
+
+	return true;
+}
+
+void UIKRig_ConstraintBones::applyConstraint(FIKRigSkeleton& IKRigSkeleton, const CConstrainedBone& ConstrainedBone)
+{
+	const FTransform& constraintTransform = IKRigSkeleton.CurrentPoseGlobal[ConstrainedBone.ConstraintBone];
+	FTransform& modifiedTransform = IKRigSkeleton.CurrentPoseGlobal[ConstrainedBone.ModifiedBone];
+
+	if (ConstrainedBone.IsFullCopy)
+	{
+		modifiedTransform = constraintTransform;
+		return;
+	}
+
+	const FTransform targetTransform = ConstrainedBone.Offset * constraintTransform;
+	const float alpha = ConstrainedBone.Alpha;
+
+	if (ConstrainedBone.Channels & ChannelTranslation)
+	{
+		modifiedTransform.SetTranslation(FMath::Lerp(modifiedTransform.GetTranslation(), targetTransform.GetTranslation(), alpha));
+	}
+
+	if (ConstrainedBone.Channels & ChannelRotation)
+	{
+		modifiedTransform.SetRotation(FQuat::Slerp(modifiedTransform.GetRotation(), targetTransform.GetRotation(), alpha));
+	}
+
+	if (ConstrainedBone.Channels & ChannelScale)
+	{
+		modifiedTransform.SetScale3D(FMath::Lerp(modifiedTransform.GetScale3D(), targetTransform.GetScale3D(), alpha));
+	}
 }
 
 #if WITH_EDITOR
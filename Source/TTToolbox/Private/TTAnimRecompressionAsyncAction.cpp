@@ -0,0 +1,88 @@
+// The MIT License (MIT)
+// ---------------------
+// 
+// Copyright 2022 Achim Turan (https://www.instagram.com/tuatec/)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all copies or
+// substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "TTAnimRecompressionAsyncAction.h"
+
+// Unreal Engine includes
+#include "Animation/AnimSequence.h"
+
+// TTToolbox includes
+#include "TTAnimRecompressionQueue.h"
+
+UTTAnimRecompressionAsyncAction* UTTAnimRecompressionAsyncAction::RequestAnimSequencesRecompressionAsync(const TArray<UAnimSequence*>& AnimSequences)
+{
+  UTTAnimRecompressionAsyncAction* asyncAction = NewObject<UTTAnimRecompressionAsyncAction>();
+  for (auto animSequence : AnimSequences)
+  {
+    if (!IsValid(animSequence))
+    {
+      UE_LOG(LogTemp, Warning, TEXT("Called \"RequestAnimSequencesRecompressionAsync\" with an invalid animation sequence, which will be skipped."));
+      continue;
+    }
+    asyncAction->m_animSequences.Add(animSequence);
+  }
+  return asyncAction;
+}
+
+void UTTAnimRecompressionAsyncAction::Activate()
+{
+  // editor utilities don't provide a game instance to register at, so the action keeps itself alive until it is finished
+  AddToRoot();
+
+  m_startTime = FPlatformTime::Seconds();
+  m_reports.Reset(m_animSequences.Num());
+
+  TArray<UAnimSequence*> animSequences(m_animSequences);
+  CAnimRecompressionQueue::Get().Enqueue(animSequences,
+    CAnimRecompressionQueue::FOnProgress(),
+    CAnimRecompressionQueue::FOnCompleted::CreateUObject(this, &UTTAnimRecompressionAsyncAction::onCompleted),
+    CAnimRecompressionQueue::FOnAnimSequenceCompressed::CreateWeakLambda(this, [this](const CAnimRecompressionQueue::CCompressionResult& Result)
+    {
+      FTTAnimSequenceCompressionReport_BP& report = m_reports.AddDefaulted_GetRef();
+      report.AnimSequence = Result.AnimSequence.Get();
+      report.CompressionTime = static_cast<float>(Result.CompressionTime);
+      report.LikelyDDCHit = Result.LikelyDDCHit;
+      report.CompressedSizeBefore = Result.CompressedSizeBefore;
+      report.CompressedSizeAfter = Result.CompressedSizeAfter;
+    }));
+}
+
+void UTTAnimRecompressionAsyncAction::onCompleted(int32 NumCompressed)
+{
+  const double totalTime = FPlatformTime::Seconds() - m_startTime;
+
+  int32 numLikelyDDCHits = 0;
+  int64 compressedSizeBefore = 0;
+  int64 compressedSizeAfter = 0;
+  for (auto& report : m_reports)
+  {
+    numLikelyDDCHits += report.LikelyDDCHit ? 1 : 0;
+    compressedSizeBefore += report.CompressedSizeBefore;
+    compressedSizeAfter += report.CompressedSizeAfter;
+  }
+
+  UE_LOG(LogTemp, Display, TEXT("Recompressed %d animation sequences in %.2f seconds (%.2f per second), %d likely DDC hits, compressed size %lld -> %lld bytes."),
+    NumCompressed, totalTime, totalTime > 0.0 ? NumCompressed / totalTime : 0.0, numLikelyDDCHits, compressedSizeBefore, compressedSizeAfter);
+
+  Completed.Broadcast(m_reports);
+
+  RemoveFromRoot();
+  SetReadyToDestroy();
+}
@@ -0,0 +1,244 @@
+// The MIT License (MIT)
+// ---------------------
+// 
+// Copyright 2022 Achim Turan (https://www.instagram.com/tuatec/)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all copies or
+// substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "TTAnimRecompressionQueue.h"
+
+// Unreal Engine includes
+#include "Animation/AnimSequence.h"
+#include "AssetCompilingManager.h"
+
+static TUniquePtr<CAnimRecompressionQueue> gs_animRecompressionQueue;
+
+CAnimRecompressionQueue& CAnimRecompressionQueue::Get()
+{
+  if (!gs_animRecompressionQueue.IsValid())
+  {
+    gs_animRecompressionQueue.Reset(new CAnimRecompressionQueue());
+    gs_animRecompressionQueue->m_tickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(gs_animRecompressionQueue.Get(), &CAnimRecompressionQueue::tick));
+  }
+
+  return *gs_animRecompressionQueue;
+}
+
+void CAnimRecompressionQueue::Shutdown()
+{
+  gs_animRecompressionQueue.Reset();
+}
+
+CAnimRecompressionQueue::~CAnimRecompressionQueue()
+{
+  FTSTicker::GetCoreTicker().RemoveTicker(m_tickerHandle);
+
+  for (auto& job : m_jobs)
+  {
+    if (job->LoadHandle.IsValid())
+    {
+      job->LoadHandle->CancelHandle();
+    }
+  }
+}
+
+void CAnimRecompressionQueue::Enqueue(TArray<FSoftObjectPath> AnimSequencePaths, FOnProgress OnProgress, FOnCompleted OnCompleted, FOnAnimSequenceCompressed OnAnimSequenceCompressed)
+{
+  TUniquePtr<CJob> job = MakeUnique<CJob>();
+  job->NumAnimSequences = AnimSequencePaths.Num();
+  job->AnimSequencePaths = MoveTemp(AnimSequencePaths);
+  job->OnProgress = MoveTemp(OnProgress);
+  job->OnCompleted = MoveTemp(OnCompleted);
+  job->OnAnimSequenceCompressed = MoveTemp(OnAnimSequenceCompressed);
+  m_jobs.Add(MoveTemp(job));
+}
+
+void CAnimRecompressionQueue::Enqueue(const TArray<UAnimSequence*>& AnimSequences, FOnProgress OnProgress, FOnCompleted OnCompleted, FOnAnimSequenceCompressed OnAnimSequenceCompressed)
+{
+  TUniquePtr<CJob> job = MakeUnique<CJob>();
+  job->NumAnimSequences = AnimSequences.Num();
+  job->Loaded.Reserve(AnimSequences.Num());
+  // the loaded animation sequences are popped from the back, so the requests keep the given order
+  for (int32 ii = AnimSequences.Num() - 1; ii >= 0; --ii)
+  {
+    job->Loaded.Emplace(AnimSequences[ii]);
+  }
+  job->OnProgress = MoveTemp(OnProgress);
+  job->OnCompleted = MoveTemp(OnCompleted);
+  job->OnAnimSequenceCompressed = MoveTemp(OnAnimSequenceCompressed);
+  m_jobs.Add(MoveTemp(job));
+}
+
+int32 CAnimRecompressionQueue::GetNumPending() const
+{
+  int32 numPending = 0;
+  for (auto& job : m_jobs)
+  {
+    numPending += job->NumAnimSequences - job->NumFinished;
+  }
+  return numPending;
+}
+
+void CAnimRecompressionQueue::Flush()
+{
+  if (m_isTicking)
+  {
+    UE_LOG(LogTemp, Error, TEXT("Flushing the animation recompression queue from within a job delegate is not supported."));
+    return;
+  }
+
+  while (m_jobs.Num() > 0)
+  {
+    if (m_jobs[0]->LoadHandle.IsValid())
+    {
+      m_jobs[0]->LoadHandle->WaitUntilComplete();
+    }
+
+    tick(0.f);
+
+    // finishes the compressions in flight, which are otherwise only finished in the next engine tick
+    FAssetCompilingManager::Get().ProcessAsyncTasks(/*bLimitExecutionTime*/false);
+    FPlatformProcess::Sleep(0.f);
+  }
+}
+
+bool CAnimRecompressionQueue::tick(float DeltaTime)
+{
+  TGuardValue<bool> isTickingGuard(m_isTicking, true);
+
+  // the jobs are processed one after another, only the compressions of the current job are in flight
+  while (m_jobs.Num() > 0)
+  {
+    CJob& job = *m_jobs[0];
+    updateLoads(job);
+    updateCompressions(job);
+
+    if (!job.IsDone())
+    {
+      break;
+    }
+
+    // the job is removed before calling the delegate, which is allowed to enqueue new jobs
+    TUniquePtr<CJob> finishedJob = MoveTemp(m_jobs[0]);
+    m_jobs.RemoveAt(0);
+
+    UE_LOG(LogTemp, Display, TEXT("Finished recompression of %d animation sequences."), finishedJob->NumCompressed);
+    finishedJob->OnCompleted.ExecuteIfBound(finishedJob->NumCompressed);
+  }
+
+  return true;
+}
+
+void CAnimRecompressionQueue::updateLoads(CJob& Job)
+{
+  if (Job.LoadHandle.IsValid())
+  {
+    if (!Job.LoadHandle->HasLoadCompleted() && !Job.LoadHandle->WasCanceled())
+    {
+      return;
+    }
+
+    TArray<UObject*> loadedAssets;
+    Job.LoadHandle->GetLoadedAssets(loadedAssets);
+    for (UObject* loadedAsset : loadedAssets)
+    {
+      if (UAnimSequence* animSequence = Cast<UAnimSequence>(loadedAsset))
+      {
+        Job.Loaded.Emplace(animSequence);
+      }
+    }
+
+    // assets that failed to load are finished as well
+    Job.NumFinished += Job.LoadHandle->GetRequestedAssets().Num() - loadedAssets.Num();
+
+    Job.LoadHandle->ReleaseHandle();
+    Job.LoadHandle.Reset();
+  }
+
+  // the next batch is loaded while the current batch is compressing
+  if (Job.NextToLoad < Job.AnimSequencePaths.Num() && Job.Loaded.Num() < LoadBatchSize)
+  {
+    const int32 batchNum = FMath::Min(LoadBatchSize, Job.AnimSequencePaths.Num() - Job.NextToLoad);
+    TArray<FSoftObjectPath> batchPaths(Job.AnimSequencePaths.GetData() + Job.NextToLoad, batchNum);
+    Job.NextToLoad += batchNum;
+
+    Job.LoadHandle = m_streamableManager.RequestAsyncLoad(MoveTemp(batchPaths), FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority);
+    if (!Job.LoadHandle.IsValid())
+    {
+      Job.NumFinished += batchNum;
+    }
+  }
+}
+
+void CAnimRecompressionQueue::updateCompressions(CJob& Job)
+{
+  const int32 numFinishedBefore = Job.NumFinished;
+  const double currentTime = FPlatformTime::Seconds();
+
+  for (int32 ii = Job.Compressing.Num() - 1; ii >= 0; --ii)
+  {
+    CCompression& compression = Job.Compressing[ii];
+    UAnimSequence* animSequence = compression.AnimSequence.Get();
+    if (animSequence->IsCompiling())
+    {
+      continue;
+    }
+
+    CCompressionResult& result = compression.Result;
+    result.CompressionTime = currentTime - result.CompressionTime;
+    result.CompressedSizeAfter = static_cast<int64>(animSequence->GetApproxCompressedSize());
+    Job.OnAnimSequenceCompressed.ExecuteIfBound(result);
+
+    Job.Compressing.RemoveAtSwap(ii);
+    Job.NumFinished++;
+  }
+
+  while (Job.Compressing.Num() < MaxCompressionsInFlight && Job.Loaded.Num() > 0)
+  {
+    TStrongObjectPtr<UAnimSequence> animSequence = Job.Loaded.Pop();
+    if (!IsValid(animSequence.Get()))
+    {
+      Job.NumFinished++;
+      continue;
+    }
+
+    CCompressionResult result;
+    result.AnimSequence = animSequence.Get();
+    result.CompressedSizeBefore = static_cast<int64>(animSequence->GetApproxCompressedSize());
+    result.CompressionTime = FPlatformTime::Seconds();
+
+    animSequence->BeginCacheDerivedDataForCurrentPlatform();
+    Job.NumCompressed++;
+
+    // compressions that are not compiling right after the request were served synchronously
+    if (!animSequence->IsCompiling())
+    {
+      result.LikelyDDCHit = true;
+      result.CompressionTime = FPlatformTime::Seconds() - result.CompressionTime;
+      result.CompressedSizeAfter = static_cast<int64>(animSequence->GetApproxCompressedSize());
+      Job.OnAnimSequenceCompressed.ExecuteIfBound(result);
+      Job.NumFinished++;
+      continue;
+    }
+
+    Job.Compressing.Add({ MoveTemp(animSequence), MoveTemp(result) });
+  }
+
+  if (Job.NumFinished != numFinishedBefore)
+  {
+    Job.OnProgress.ExecuteIfBound(Job.NumFinished, Job.NumAnimSequences);
+  }
+}
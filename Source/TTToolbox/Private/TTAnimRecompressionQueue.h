@@ -0,0 +1,124 @@
+// The MIT License (MIT)
+// ---------------------
+// 
+// Copyright 2022 Achim Turan (https://www.instagram.com/tuatec/)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all copies or
+// substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Engine/StreamableManager.h"
+#include "UObject/StrongObjectPtr.h"
+
+// forward declarations
+class UAnimSequence;
+
+// Work queue for animation sequence recompressions, driven by the core ticker.
+// The animation sequences are loaded asynchronously in batches and only a limited number of compressions
+// are requested at the same time, so the editor stays responsive while thousands of sequences get recompressed.
+// The queued animation sequences are kept alive by the queue until their compression has finished.
+// Synchronous callers have to call 'Flush', otherwise the compressions are requested in later ticks.
+class CAnimRecompressionQueue
+{
+public:
+  // result of a single compression
+  struct CCompressionResult
+  {
+    TWeakObjectPtr<UAnimSequence> AnimSequence;
+    // time in seconds between the compression request and the tick the compression was noticed as finished
+    double CompressionTime = 0.0;
+    // Heuristic: the compression was already finished right after the request, which is
+    // usually the case if the compressed data could be fetched from the derived data cache.
+    bool LikelyDDCHit = false;
+    int64 CompressedSizeBefore = 0;
+    int64 CompressedSizeAfter = 0;
+  };
+
+  DECLARE_DELEGATE_TwoParams(FOnProgress, int32 /*NumFinished*/, int32 /*NumAnimSequences*/);
+  DECLARE_DELEGATE_OneParam(FOnCompleted, int32 /*NumCompressed*/);
+  DECLARE_DELEGATE_OneParam(FOnAnimSequenceCompressed, const CCompressionResult& /*Result*/);
+
+  static constexpr int32 LoadBatchSize = 32;
+  static constexpr int32 MaxCompressionsInFlight = 16;
+
+  // returns the queue, the queue registers itself at the core ticker on the first call
+  static CAnimRecompressionQueue& Get();
+
+  // unregisters from the core ticker and destroys the queue including all pending jobs, called on module shutdown
+  static void Shutdown();
+
+  ~CAnimRecompressionQueue();
+
+  // Adds a recompression job for the given animation sequences. 'OnProgress' is called whenever compressions
+  // have finished and 'OnCompleted' when all compressions of the job have finished.
+  void Enqueue(TArray<FSoftObjectPath> AnimSequencePaths, FOnProgress OnProgress = FOnProgress(), FOnCompleted OnCompleted = FOnCompleted(),
+    FOnAnimSequenceCompressed OnAnimSequenceCompressed = FOnAnimSequenceCompressed());
+
+  // same as above for already loaded animation sequences
+  void Enqueue(const TArray<UAnimSequence*>& AnimSequences, FOnProgress OnProgress = FOnProgress(), FOnCompleted OnCompleted = FOnCompleted(),
+    FOnAnimSequenceCompressed OnAnimSequenceCompressed = FOnAnimSequenceCompressed());
+
+  // returns the number of animation sequences that are not compressed yet
+  int32 GetNumPending() const;
+
+  // Blocks until all queued jobs have finished, including the jobs enqueued by other callers.
+  // Must not be called from within one of the delegates of a job.
+  void Flush();
+
+private:
+  CAnimRecompressionQueue() = default;
+
+  // compression in flight, the animation sequence is kept alive until the compression has finished
+  struct CCompression
+  {
+    TStrongObjectPtr<UAnimSequence> AnimSequence;
+    // 'CompressionTime' stores the start time until finished
+    CCompressionResult Result;
+  };
+
+  struct CJob
+  {
+    int32 NumAnimSequences = 0;
+    TArray<FSoftObjectPath> AnimSequencePaths;
+    // index of the next animation sequence to load
+    int32 NextToLoad = 0;
+    TSharedPtr<FStreamableHandle> LoadHandle;
+    // loaded animation sequences waiting for their compression request, the loaded batch isn't
+    // referenced by the load handle anymore and needs to be kept alive here
+    TArray<TStrongObjectPtr<UAnimSequence>> Loaded;
+    // animation sequences that are compressing right now
+    TArray<CCompression> Compressing;
+    int32 NumCompressed = 0;
+    int32 NumFinished = 0;
+
+    FOnProgress OnProgress;
+    FOnCompleted OnCompleted;
+    FOnAnimSequenceCompressed OnAnimSequenceCompressed;
+
+    bool IsDone() const { return NextToLoad >= AnimSequencePaths.Num() && !LoadHandle.IsValid() && Loaded.IsEmpty() && Compressing.IsEmpty(); }
+  };
+
+  bool tick(float DeltaTime);
+  void updateLoads(CJob& Job);
+  void updateCompressions(CJob& Job);
+
+  TArray<TUniquePtr<CJob>> m_jobs;
+  FStreamableManager m_streamableManager;
+  FTSTicker::FDelegateHandle m_tickerHandle;
+  bool m_isTicking = false;
+};
@@ -0,0 +1,143 @@
+// The MIT License (MIT)
+// ---------------------
+// 
+// Copyright 2022 Achim Turan (https://www.instagram.com/tuatec/)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all copies or
+// substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "TTBoneIndexRemap.h"
+
+// Unreal Engine includes
+#include "Rendering/SkeletalMeshLODModel.h"
+#include "Rendering/SkeletalMeshLODImporterData.h"
+
+CBoneIndexRemap CBoneIndexRemap::CreateInsertion(int32 NumBones, int32 InsertIndex, int32 NumInsertedBones)
+{
+  check(InsertIndex >= 0 && InsertIndex <= NumBones && NumInsertedBones >= 0);
+
+  CBoneIndexRemap remap;
+  remap.m_numOldBones = NumBones;
+  remap.m_shiftStart = InsertIndex;
+  remap.m_shiftOffset = NumInsertedBones;
+  return remap;
+}
+
+CBoneIndexRemap CBoneIndexRemap::CreateInsertions(int32 NumBones, const TArray<int32>& InsertIndices)
+{
+  // count the inserted bones in front of each old bone, the last entry counts the bones appended behind the last bone
+  TArray<int32> numInsertedBones;
+  numInsertedBones.Init(0, NumBones + 1);
+  for (int32 insertIndex : InsertIndices)
+  {
+    check(insertIndex >= 0 && insertIndex <= NumBones);
+    ++numInsertedBones[insertIndex];
+  }
+
+  CBoneIndexRemap remap;
+  remap.m_numOldBones = NumBones;
+  remap.m_table.SetNumUninitialized(NumBones);
+
+  int32 offset = 0;
+  for (int32 ii = 0; ii < NumBones; ++ii)
+  {
+    offset += numInsertedBones[ii];
+    remap.m_table[ii] = ii + offset;
+  }
+
+  return remap;
+}
+
+CBoneIndexRemap CBoneIndexRemap::CreateRemoval(const TArray<int32>& ParentIndices, const TArray<int32>& RemovedBones)
+{
+  const int32 numBones = ParentIndices.Num();
+
+  TBitArray<> isRemoved(false, numBones);
+  for (int32 removedBone : RemovedBones)
+  {
+    check(removedBone >= 0 && removedBone < numBones);
+    isRemoved[removedBone] = true;
+  }
+
+  CBoneIndexRemap remap;
+  remap.m_numOldBones = numBones;
+  remap.m_table.SetNumUninitialized(numBones);
+
+  // bones are stored in hierarchy order, so the parents are always remapped before their children
+  int32 newIndex = 0;
+  for (int32 ii = 0; ii < numBones; ++ii)
+  {
+    if (!isRemoved[ii])
+    {
+      remap.m_table[ii] = newIndex++;
+      continue;
+    }
+
+    const int32 parentIndex = ParentIndices[ii];
+    checkf(parentIndex != INDEX_NONE, TEXT("Removing a root bone is not supported."));
+    check(parentIndex < ii);
+    remap.m_table[ii] = remap.m_table[parentIndex];
+  }
+
+  return remap;
+}
+
+CBoneIndexRemap CBoneIndexRemap::CreateReorder(const TArray<int32>& NewOrder)
+{
+  CBoneIndexRemap remap;
+  remap.m_numOldBones = NewOrder.Num();
+  remap.m_table.Init(INDEX_NONE, NewOrder.Num());
+  for (int32 newIndex = 0; newIndex < NewOrder.Num(); ++newIndex)
+  {
+    const int32 oldIndex = NewOrder[newIndex];
+    check(oldIndex >= 0 && oldIndex < NewOrder.Num() && remap.m_table[oldIndex] == INDEX_NONE);
+    remap.m_table[oldIndex] = newIndex;
+  }
+
+  return remap;
+}
+
+void CBoneIndexRemap::ApplyToLODModel(FSkeletalMeshLODModel& LODModel, bool RemapBoneMaps) const
+{
+  ApplyToBoneList(LODModel.ActiveBoneIndices);
+  ApplyToBoneList(LODModel.RequiredBones);
+
+  // update bone references used by the skin weights
+  for (auto& skinWeightsProfile : LODModel.SkinWeightProfiles)
+  {
+    FImportedSkinWeightProfileData& importedSkinWeightProfileData = skinWeightsProfile.Value;
+
+    for (auto& skinWeight : importedSkinWeightProfileData.SkinWeights)
+    {
+      Apply(skinWeight.InfluenceBones, MAX_TOTAL_INFLUENCES);
+    }
+
+    Apply(importedSkinWeightProfileData.SourceModelInfluences, &SkeletalMeshImportData::FVertInfluence::BoneIndex);
+  }
+
+  if (RemapBoneMaps)
+  {
+    for (auto& LODSection : LODModel.Sections)
+    {
+      Apply(LODSection.BoneMap);
+    }
+  }
+}
+
+void CBoneIndexRemap::ApplyToImportData(FSkeletalMeshImportData& ImportData) const
+{
+  Apply(ImportData.RefBonesBinary, &SkeletalMeshImportData::FBone::ParentIndex);
+  Apply(ImportData.Influences, &SkeletalMeshImportData::FRawBoneInfluence::BoneIndex);
+}
@@ -0,0 +1,160 @@
+// The MIT License (MIT)
+// ---------------------
+// 
+// Copyright 2022 Achim Turan (https://www.instagram.com/tuatec/)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all copies or
+// substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/IsSigned.h"
+
+// forward declarations
+class FSkeletalMeshLODModel;
+class FSkeletalMeshImportData;
+
+// Maps the bone indices of a reference skeleton before a hierarchy change (old) to the bone indices after the change (new).
+// The same remap is applied to all buffers that reference bones (LOD models, skin weight profiles, import data),
+// which makes it possible to insert, remove and reorder bones with a single implementation.
+// A single insertion is stored as a plain shift, all other changes use an old -> new lookup table.
+struct CBoneIndexRemap
+{
+  // 'NumInsertedBones' bones get inserted at 'InsertIndex', all bones starting at 'InsertIndex' are moved behind the inserted bones.
+  static CBoneIndexRemap CreateInsertion(int32 NumBones, int32 InsertIndex, int32 NumInsertedBones = 1);
+
+  // Inserts bones at arbitrary positions. 'InsertIndices' are old bone indices, a bone is inserted in front of the old bone
+  // (or behind the last bone for 'NumBones'). The same index can be passed multiple times to insert several bones at once.
+  static CBoneIndexRemap CreateInsertions(int32 NumBones, const TArray<int32>& InsertIndices);
+
+  // Removes the given bones, references to a removed bone are mapped to its closest remaining parent
+  // so skin weights are transferred to the parent. 'ParentIndices' describes the hierarchy before the removal.
+  static CBoneIndexRemap CreateRemoval(const TArray<int32>& ParentIndices, const TArray<int32>& RemovedBones);
+
+  // Reorders the bones, 'NewOrder[NewIndex]' contains the old index of the bone.
+  static CBoneIndexRemap CreateReorder(const TArray<int32>& NewOrder);
+
+  // number of bones before the hierarchy change
+  int32 GetNumOldBones() const { return m_numOldBones; }
+
+  // returns the new bone index, INDEX_NONE stays INDEX_NONE
+  FORCEINLINE int32 Remap(int32 OldIndex) const
+  {
+    checkSlow(OldIndex >= INDEX_NONE && OldIndex < m_numOldBones);
+    if (OldIndex == INDEX_NONE)
+    {
+      return OldIndex;
+    }
+
+    if (m_table.Num() == 0)
+    {
+      return OldIndex >= m_shiftStart ? OldIndex + m_shiftOffset : OldIndex;
+    }
+
+    return m_table[OldIndex];
+  }
+
+  // Remaps a contiguous buffer of bone indices. For signed index types INDEX_NONE stays INDEX_NONE,
+  // unsigned index types (e.g. the uint16 section bone maps) can't store INDEX_NONE and are always remapped.
+  template<typename IndexType>
+  void Apply(IndexType* Indices, int32 NumIndices) const
+  {
+    if (m_table.Num() == 0)
+    {
+      // branch free shift, which can be vectorized by the compiler
+      // INDEX_NONE is always smaller than the (non negative) insert index and stays untouched
+      const IndexType shiftStart = static_cast<IndexType>(m_shiftStart);
+      const IndexType shiftOffset = static_cast<IndexType>(m_shiftOffset);
+      for (int32 ii = 0; ii < NumIndices; ++ii)
+      {
+        const IndexType index = Indices[ii];
+        checkSlow(static_cast<int32>(index) < m_numOldBones);
+        Indices[ii] = index + (index >= shiftStart ? shiftOffset : IndexType(0));
+      }
+      return;
+    }
+
+    const int32* table = m_table.GetData();
+    for (int32 ii = 0; ii < NumIndices; ++ii)
+    {
+      const IndexType index = Indices[ii];
+      if constexpr (TIsSigned<IndexType>::Value)
+      {
+        if (index == IndexType(INDEX_NONE))
+        {
+          continue;
+        }
+      }
+
+      check(static_cast<int32>(index) >= 0 && static_cast<int32>(index) < m_numOldBones);
+      Indices[ii] = static_cast<IndexType>(table[index]);
+    }
+  }
+
+  template<typename IndexType, typename AllocatorType>
+  void Apply(TArray<IndexType, AllocatorType>& Indices) const
+  {
+    Apply(Indices.GetData(), Indices.Num());
+  }
+
+  // remaps the bone index member of each element, e.g. the influences of the import data
+  template<typename ElementType, typename IndexType>
+  void Apply(TArray<ElementType>& Elements, IndexType ElementType::* IndexMember) const
+  {
+    for (ElementType& element : Elements)
+    {
+      element.*IndexMember = static_cast<IndexType>(Remap(element.*IndexMember));
+    }
+  }
+
+  // Remaps a sorted list of bone indices (active bones, required bones). Removed bones can produce duplicates
+  // and reorders change the order, that's why the list is sorted and made unique afterwards for table remaps.
+  template<typename IndexType, typename AllocatorType>
+  void ApplyToBoneList(TArray<IndexType, AllocatorType>& BoneList) const
+  {
+    Apply(BoneList);
+    if (m_table.Num() > 0)
+    {
+      BoneList.Sort();
+      for (int32 ii = BoneList.Num() - 1; ii > 0; --ii)
+      {
+        if (BoneList[ii] == BoneList[ii - 1])
+        {
+          BoneList.RemoveAt(ii);
+        }
+      }
+    }
+  }
+
+  // Remaps the active bones, required bones and skin weight profiles of the LOD model.
+  // The section bone maps are only remapped if 'RemapBoneMaps' is true, as they are rebuilt from the import data otherwise.
+  // Newly inserted bones are not added to any list.
+  void ApplyToLODModel(FSkeletalMeshLODModel& LODModel, bool RemapBoneMaps) const;
+
+  // Remaps the parent indices of the reference bones and the bone influences of the import data.
+  // The reference bones are neither inserted, removed nor reordered, this needs to be done by the caller.
+  void ApplyToImportData(FSkeletalMeshImportData& ImportData) const;
+
+private:
+  int32 m_numOldBones = 0;
+
+  // shift of a single insertion: indices >= m_shiftStart are increased by m_shiftOffset
+  int32 m_shiftStart = 0;
+  int32 m_shiftOffset = 0;
+
+  // old -> new lookup table, empty for a single insertion
+  TArray<int32> m_table;
+};
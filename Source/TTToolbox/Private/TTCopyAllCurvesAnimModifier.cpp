@@ -22,6 +22,16 @@
 
 // Unreal Engine includes
 #include "Animation/AnimSequence.h"
+#include "Animation/AnimData/IAnimationDataController.h"
+#include "Animation/AnimData/IAnimationDataModel.h"
+
+// TTToolbox includes
+#include "TTCurveUtils.h"
+
+#define LOCTEXT_NAMESPACE "TTCopyAllCurvesAnimModifier"
+
+// helper function prototypes
+static uint32 getCurveKeysHash(const TArray<FRichCurveKey>& Keys);
 
 void UTTCopyAllCurvesAnimModifier::OnApply_Implementation(UAnimSequence* TargetSequence)
 {
@@ -32,27 +42,96 @@ void UTTCopyAllCurvesAnimModifier::OnApply_Implementation(UAnimSequence* TargetS
     return;
   }
 
+  const TArray<FFloatCurve>& sourceCurves = SourceSequence->GetCurveData().FloatCurves;
+  const IAnimationDataModel* targetDataModel = TargetSequence->GetDataModel();
+  IAnimationDataController& controller = TargetSequence->GetController();
+
+  // prepare and hash the keys once, they are compared against the target keys to skip unchanged curves
+  TArray<TArray<FRichCurveKey>> curveKeys;
+  curveKeys.SetNum(sourceCurves.Num());
+  TMap<FName, uint32> sourceCurveHashes;
+  sourceCurveHashes.Reserve(sourceCurves.Num());
+  for (int32 curveIndex = 0; curveIndex < sourceCurves.Num(); curveIndex++)
+  {
+    const FFloatCurve& sourceCurve = sourceCurves[curveIndex];
+    CCurveUtils::PrepareKeys(sourceCurve.FloatCurve, CurveCopyOptions, targetDataModel->GetFrameRate(), targetDataModel->GetPlayLength(), curveKeys[curveIndex]);
+    sourceCurveHashes.Add(sourceCurve.GetName(), getCurveKeysHash(curveKeys[curveIndex]));
+  }
+
+  // all edits are batched into a single bracket, so the data model only notifies once
+  IAnimationDataController::FScopedBracket scopedBracket(controller, LOCTEXT("CopyAllCurves", "Copy All Curves"));
+
   if (ReplaceExistingCurves)
   {
-    UAnimationBlueprintLibrary::RemoveAllCurveData(TargetSequence);
+    // Only float curves which are not part of the source sequence are removed, the others are overwritten below.
+    // The source sequence doesn't provide any transform curves, that's why all of them are removed.
+    TArray<FAnimationCurveIdentifier> curvesToRemove;
+    for (auto& targetCurve : targetDataModel->GetFloatCurves())
+    {
+      if (!sourceCurveHashes.Contains(targetCurve.GetName()))
+      {
+        curvesToRemove.Add(FAnimationCurveIdentifier(targetCurve.GetName(), ERawCurveTrackTypes::RCT_Float));
+      }
+    }
+
+    for (auto& targetCurve : targetDataModel->GetTransformCurves())
+    {
+      curvesToRemove.Add(FAnimationCurveIdentifier(targetCurve.GetName(), ERawCurveTrackTypes::RCT_Transform));
+    }
+
+    for (auto& curveId : curvesToRemove)
+    {
+      controller.RemoveCurve(curveId);
+    }
   }
 
   // copy all curves to the target anim sequence
-  for (auto& sourceCurve : SourceSequence->GetCurveData().FloatCurves)
+  int32 numSkippedCurves = 0;
+  for (int32 curveIndex = 0; curveIndex < sourceCurves.Num(); curveIndex++)
   {
-    // remove the curve if it already exists ==> overwrite
-    if (UAnimationBlueprintLibrary::DoesCurveExist(TargetSequence, sourceCurve.GetName(), ERawCurveTrackTypes::RCT_Float))
+    const FFloatCurve& sourceCurve = sourceCurves[curveIndex];
+    const FAnimationCurveIdentifier curveId(sourceCurve.GetName(), ERawCurveTrackTypes::RCT_Float);
+
+    if (const FFloatCurve* targetCurve = targetDataModel->FindFloatCurve(curveId))
     {
-      UAnimationBlueprintLibrary::RemoveCurve(TargetSequence, sourceCurve.GetName());
+      // skip the curve if the keys already match, the hash only rejects different keys fast and equal hashes are verified key by key
+      const TArray<FRichCurveKey>& targetKeys = targetCurve->FloatCurve.GetConstRefOfKeys();
+      if (getCurveKeysHash(targetKeys) == sourceCurveHashes.FindChecked(sourceCurve.GetName()) && targetKeys == curveKeys[curveIndex])
+      {
+        numSkippedCurves++;
+        continue;
+      }
+    }
+    else
+    {
+      // introduce the curve
+      controller.AddCurve(curveId);
     }
 
-    // introduce the curve
-    UAnimationBlueprintLibrary::AddCurve(TargetSequence, sourceCurve.GetName());
+    // transfer curve keys, this overwrites already existing keys
+    controller.SetCurveKeys(curveId, curveKeys[curveIndex]);
+  }
 
-    // prepare needed objects to set the curve keys
-    const FAnimationCurveIdentifier curveId(sourceCurve.GetName(), ERawCurveTrackTypes::RCT_Float);
+  UE_LOG(LogTemp, Verbose, TEXT("Copied %d curves to \"%s\", skipped %d unchanged curves."), sourceCurves.Num() - numSkippedCurves, *TargetSequence->GetPathName(), numSkippedCurves);
+}
 
-    // transfer curve keys
-    TargetSequence->GetController().SetCurveKeys(curveId, sourceCurve.FloatCurve.GetConstRefOfKeys());
+static uint32 getCurveKeysHash(const TArray<FRichCurveKey>& Keys)
+{
+  uint32 hash = GetTypeHash(Keys.Num());
+  for (auto& key : Keys)
+  {
+    hash = HashCombine(hash, GetTypeHash(key.Time));
+    hash = HashCombine(hash, GetTypeHash(key.Value));
+    hash = HashCombine(hash, GetTypeHash(key.ArriveTangent));
+    hash = HashCombine(hash, GetTypeHash(key.LeaveTangent));
+    hash = HashCombine(hash, GetTypeHash(key.ArriveTangentWeight));
+    hash = HashCombine(hash, GetTypeHash(key.LeaveTangentWeight));
+    hash = HashCombine(hash, GetTypeHash(static_cast<uint8>(key.InterpMode.GetValue())));
+    hash = HashCombine(hash, GetTypeHash(static_cast<uint8>(key.TangentMode.GetValue())));
+    hash = HashCombine(hash, GetTypeHash(static_cast<uint8>(key.TangentWeightMode.GetValue())));
   }
+
+  return hash;
 }
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,136 @@
+// The MIT License (MIT)
+// ---------------------
+// 
+// Copyright 2022 Achim Turan (https://www.instagram.com/tuatec/)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all copies or
+// substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "TTCurveUtils.h"
+
+// TTToolbox includes
+#include "TTToolboxTypes.h"
+
+// helper function prototypes
+static bool canRemoveKey(const TArray<FRichCurveKey>& Keys, int32 AnchorIndex, int32 KeyIndex, float Tolerance);
+static int32 getNumFrames(const FFrameRate& FrameRate, double PlayLength);
+
+void CCurveUtils::PrepareKeys(const FRichCurve& SourceCurve, const FTTCurveCopyOptions& Options, const FFrameRate& TargetFrameRate, double TargetPlayLength, TArray<FRichCurveKey>& OutKeys)
+{
+  // Resampling only pays off for curves with more keys than target frames, sparse curves would be expanded
+  // and lose their cubic interpolation. The linear keys of the resampling are always reduced afterwards.
+  const bool resample = Options.ResampleToTargetFrameRate && TargetFrameRate.IsValid() &&
+    SourceCurve.GetNumKeys() > getNumFrames(TargetFrameRate, TargetPlayLength) + 1;
+
+  if (resample)
+  {
+    ResampleKeys(SourceCurve, TargetFrameRate, TargetPlayLength, OutKeys);
+  }
+  else
+  {
+    OutKeys = SourceCurve.GetConstRefOfKeys();
+  }
+
+  if (Options.ReduceKeys || resample)
+  {
+    ReduceKeys(OutKeys, Options.ReductionTolerance);
+  }
+}
+
+void CCurveUtils::ResampleKeys(const FRichCurve& SourceCurve, const FFrameRate& FrameRate, double PlayLength, TArray<FRichCurveKey>& OutKeys)
+{
+  const int32 numFrames = getNumFrames(FrameRate, PlayLength);
+
+  OutKeys.Reset(numFrames + 1);
+  for (int32 frame = 0; frame <= numFrames; frame++)
+  {
+    const float time = static_cast<float>(FrameRate.AsSeconds(FFrameNumber(frame)));
+    FRichCurveKey& key = OutKeys.Emplace_GetRef(time, SourceCurve.Eval(time));
+    key.InterpMode = RCIM_Linear;
+  }
+}
+
+void CCurveUtils::ReduceKeys(TArray<FRichCurveKey>& Keys, float Tolerance)
+{
+  if (Keys.Num() <= 2)
+  {
+    return;
+  }
+
+  // the keys are compacted in place, 'anchorIndex' is the last kept key
+  int32 anchorIndex = 0;
+  int32 numKeptKeys = 1;
+  const int32 lastIndex = Keys.Num() - 1;
+  for (int32 keyIndex = 1; keyIndex < lastIndex; keyIndex++)
+  {
+    if (canRemoveKey(Keys, anchorIndex, keyIndex, Tolerance))
+    {
+      continue;
+    }
+
+    // only keys before the new anchor are overwritten, which are not needed by the following checks anymore
+    anchorIndex = keyIndex;
+    Keys[numKeptKeys++] = Keys[keyIndex];
+  }
+
+  Keys[numKeptKeys++] = Keys[lastIndex];
+  Keys.SetNum(numKeptKeys);
+}
+
+static bool canRemoveKey(const TArray<FRichCurveKey>& Keys, int32 AnchorIndex, int32 KeyIndex, float Tolerance)
+{
+  const FRichCurveKey& anchorKey = Keys[AnchorIndex];
+  const FRichCurveKey& key = Keys[KeyIndex];
+  if (anchorKey.InterpMode != key.InterpMode)
+  {
+    return false;
+  }
+
+  // a constant key is redundant if it repeats the value of the previous kept key
+  if (key.InterpMode == RCIM_Constant)
+  {
+    return FMath::IsNearlyEqual(anchorKey.Value, key.Value, Tolerance);
+  }
+
+  if (key.InterpMode != RCIM_Linear)
+  {
+    return false;
+  }
+
+  // a linear key is redundant if the line between the previous kept key and the next key
+  // goes through all keys which have been removed since the previous kept key
+  const FRichCurveKey& nextKey = Keys[KeyIndex + 1];
+  const float duration = nextKey.Time - anchorKey.Time;
+  if (duration <= UE_SMALL_NUMBER)
+  {
+    return false;
+  }
+
+  for (int32 index = AnchorIndex + 1; index <= KeyIndex; index++)
+  {
+    const float alpha = (Keys[index].Time - anchorKey.Time) / duration;
+    if (!FMath::IsNearlyEqual(FMath::Lerp(anchorKey.Value, nextKey.Value, alpha), Keys[index].Value, Tolerance))
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static int32 getNumFrames(const FFrameRate& FrameRate, double PlayLength)
+{
+  return FMath::Max(FMath::RoundToInt32(PlayLength * FrameRate.AsDecimal()), 0);
+}
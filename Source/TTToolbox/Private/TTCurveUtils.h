@@ -0,0 +1,45 @@
+// The MIT License (MIT)
+// ---------------------
+// 
+// Copyright 2022 Achim Turan (https://www.instagram.com/tuatec/)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all copies or
+// substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Curves/RichCurve.h"
+#include "Misc/FrameRate.h"
+
+// forward declarations
+struct FTTCurveCopyOptions;
+
+// Helper functions to prepare curve keys before they are copied to another animation asset.
+class CCurveUtils
+{
+public:
+  // copies the keys of 'SourceCurve' to 'OutKeys' and applies the resampling and key reduction of the 'Options'.
+  // 'TargetFrameRate' and 'TargetPlayLength' describe the animation asset the keys are copied to. Only curves with more keys
+  // than target frames are resampled and the resampled keys are always reduced with the 'ReductionTolerance' of the 'Options'.
+  static void PrepareKeys(const FRichCurve& SourceCurve, const FTTCurveCopyOptions& Options, const FFrameRate& TargetFrameRate, double TargetPlayLength, TArray<FRichCurveKey>& OutKeys);
+
+  // samples 'SourceCurve' once per frame of 'FrameRate' in the range [0, PlayLength] and stores linear keys in 'OutKeys'
+  static void ResampleKeys(const FRichCurve& SourceCurve, const FFrameRate& FrameRate, double PlayLength, TArray<FRichCurveKey>& OutKeys);
+
+  // removes linear and constant keys in place which can be reconstructed by the remaining keys within the 'Tolerance',
+  // cubic keys and the first and last key are always kept
+  static void ReduceKeys(TArray<FRichCurveKey>& Keys, float Tolerance);
+};
@@ -0,0 +1,625 @@
+// The MIT License (MIT)
+// ---------------------
+// 
+// Copyright 2022 Achim Turan (https://www.instagram.com/tuatec/)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all copies or
+// substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "TTIntegrationCommandlet.h"
+
+// Unreal Engine includes
+#include "Animation/Skeleton.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/DataTable.h"
+#include "Engine/SkeletalMesh.h"
+#include "Rig/IKRigDefinition.h"
+#include "FileHelpers.h"
+#include "UObject/TextProperty.h"
+#include "UObject/UnrealType.h"
+
+// TTToolbox includes
+#include "TTToolboxBlueprintLibrary.h"
+#include "TTSkeletalMeshRegistry.h"
+
+// all data of the integration data tables that gets applied to the skeletons
+struct CIntegrationData
+{
+  // new bones modify the skeletal meshes as well, that's why they are not part of the integration profile
+  TArray<FTTNewBone_BP> UnweightedBones;
+  FTTIntegrationProfile Profile;
+  // applied to the ik rigs
+  TArray<FBoneChain_BP> BoneChains;
+};
+
+// A structure value inside of a data table row, which is either the row itself or a structure nested in the row (e.g. an array element).
+// The shipped data tables use Blueprint structures (ST_TT*), that's why all values are read through reflection.
+struct CRowEntry
+{
+  const UStruct* Struct = nullptr;
+  const uint8* Data = nullptr;
+};
+
+// Field names of the integration data. Fields are matched by their authored name (the name shown in the Blueprint structure editor)
+// ignoring case, spaces and underscores, so the Blueprint structures and the native TTToolbox row structures are read the same way.
+static const TCHAR* const gs_newBoneNameFields[] = { TEXT("NewBoneName"), TEXT("NewBone"), TEXT("UnweightedBoneName"), TEXT("UnweightedBone") };
+static const TCHAR* const gs_parentBoneFields[] = { TEXT("ParentBone"), TEXT("ParentBoneName"), TEXT("Parent") };
+static const TCHAR* const gs_constraintBoneFields[] = { TEXT("ConstraintBone"), TEXT("ConstraintBoneName") };
+static const TCHAR* const gs_virtualBoneNameFields[] = { TEXT("VirtualBoneName"), TEXT("VirtualBone") };
+static const TCHAR* const gs_sourceBoneFields[] = { TEXT("SourceBoneName"), TEXT("SourceBone"), TEXT("Source") };
+static const TCHAR* const gs_targetBoneFields[] = { TEXT("TargetBoneName"), TEXT("TargetBone"), TEXT("Target") };
+static const TCHAR* const gs_socketNameFields[] = { TEXT("SocketName"), TEXT("Socket") };
+static const TCHAR* const gs_socketBoneFields[] = { TEXT("BoneName"), TEXT("Bone"), TEXT("ParentBone"), TEXT("ParentBoneName") };
+static const TCHAR* const gs_transformFields[] = { TEXT("RelativeTransform"), TEXT("Transform") };
+static const TCHAR* const gs_locationFields[] = { TEXT("RelativeLocation"), TEXT("Location"), TEXT("Translation") };
+static const TCHAR* const gs_rotationFields[] = { TEXT("RelativeRotation"), TEXT("Rotation") };
+static const TCHAR* const gs_scaleFields[] = { TEXT("RelativeScale"), TEXT("Scale"), TEXT("Scale3D") };
+static const TCHAR* const gs_blendValuesFields[] = { TEXT("BlendValues"), TEXT("BoneBlendValues"), TEXT("Values") };
+static const TCHAR* const gs_blendProfileNameFields[] = { TEXT("BlendProfileName"), TEXT("BlendProfile"), TEXT("ProfileName") };
+static const TCHAR* const gs_blendProfileModeFields[] = { TEXT("BlendProfileMode"), TEXT("Mode") };
+static const TCHAR* const gs_slotGroupNameFields[] = { TEXT("GroupName"), TEXT("SlotGroupName"), TEXT("SlotGroup") };
+static const TCHAR* const gs_slotNamesFields[] = { TEXT("SlotNames"), TEXT("Slots") };
+static const TCHAR* const gs_chainNameFields[] = { TEXT("ChainName"), TEXT("BoneChainName"), TEXT("BoneChain") };
+static const TCHAR* const gs_startBoneFields[] = { TEXT("StartBone"), TEXT("StartBoneName") };
+static const TCHAR* const gs_endBoneFields[] = { TEXT("EndBone"), TEXT("EndBoneName") };
+static const TCHAR* const gs_ikGoalNameFields[] = { TEXT("IKGoalName"), TEXT("IKGoal"), TEXT("GoalName"), TEXT("Goal") };
+static const TCHAR* const gs_curveNameFields[] = { TEXT("CurveName"), TEXT("CurveNames") };
+static const TCHAR* const gs_materialFields[] = { TEXT("Material") };
+static const TCHAR* const gs_morphTargetFields[] = { TEXT("MorphTarget") };
+
+// helper functions
+static TArray<FString> parseAssetList(const TMap<FString, FString>& ParamVals, const TCHAR* Key);
+static bool forEachEntry(const FString& DataPath, const TCHAR* DataTableName, TArrayView<const TCHAR* const> KeyFieldNames, TFunctionRef<bool(const FName&, const CRowEntry&)> Visitor);
+static void collectEntries(const UStruct* Struct, const uint8* Data, TArrayView<const TCHAR* const> KeyFieldNames, TArray<CRowEntry>& OutEntries);
+static const FProperty* findField(const UStruct* Struct, TArrayView<const TCHAR* const> FieldNames);
+static FString normalizeFieldName(const FString& FieldName);
+static bool getNameValue(const FProperty* Property, const void* Value, FName& OutName);
+static bool readName(const CRowEntry& Entry, TArrayView<const TCHAR* const> FieldNames, FName& OutName);
+static bool readNames(const CRowEntry& Entry, TArrayView<const TCHAR* const> FieldNames, TArray<FName>& OutNames);
+static bool readBool(const CRowEntry& Entry, TArrayView<const TCHAR* const> FieldNames, bool& OutValue);
+static bool readTransform(const CRowEntry& Entry, FTransform& OutTransform);
+static bool readBlendProfileMode(const CRowEntry& Entry, EBlendProfileMode& OutBlendProfileMode);
+static bool readBlendValues(const CRowEntry& Entry, TMap<FName, float>& OutBlendValues);
+static bool readIntegrationData(const FString& DataPath, CIntegrationData& OutIntegrationData);
+static bool applyIntegrationData(const CIntegrationData& IntegrationData, USkeleton* Skeleton);
+static void addSkeletonPackages(USkeleton* Skeleton, TArray<UPackage*>& OutPackages);
+
+UTTIntegrationCommandlet::UTTIntegrationCommandlet()
+{
+  IsClient = false;
+  IsServer = false;
+  IsEditor = true;
+  LogToConsole = true;
+}
+
+int32 UTTIntegrationCommandlet::Main(const FString& Params)
+{
+  TArray<FString> tokens;
+  TArray<FString> switches;
+  TMap<FString, FString> paramVals;
+  ParseCommandLine(*Params, tokens, switches, paramVals);
+
+  const TArray<FString> skeletonPaths = parseAssetList(paramVals, TEXT("Skeletons"));
+  const TArray<FString> ikRigPaths = parseAssetList(paramVals, TEXT("IKRigs"));
+  const FString* dataPath = paramVals.Find(TEXT("DataPath"));
+  const bool addRootBone = switches.Contains(TEXT("AddRootBone"));
+  const bool noSave = switches.Contains(TEXT("NoSave"));
+
+  if (skeletonPaths.IsEmpty() && ikRigPaths.IsEmpty())
+  {
+    UE_LOG(LogTemp, Error, TEXT("No skeletons or ik rigs given. Usage: -run=TTIntegration -Skeletons=<Skeleton>,... [-IKRigs=<IKRig>,...] [-DataPath=/TTToolbox/Data] [-AddRootBone] [-NoSave]"));
+    return 1;
+  }
+
+  // The asset registry is scanned asynchronously in commandlets as well, the skeletal meshes
+  // of the skeletons are found through the asset registry and would be missed otherwise.
+  IAssetRegistry& assetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+  assetRegistry.SearchAllAssets(/*bSynchronousSearch*/true);
+
+  CIntegrationData integrationData;
+  if (!readIntegrationData(dataPath != nullptr ? *dataPath : TEXT("/TTToolbox/Data"), integrationData))
+  {
+    return 1;
+  }
+
+  UE_LOG(LogTemp, Display, TEXT("Read %d unweighted bones, %d virtual bones, %d sockets, %d blend profiles, %d slot groups, %d ik bone chains and %d curves."),
+    integrationData.UnweightedBones.Num(), integrationData.Profile.VirtualBones.Num(), integrationData.Profile.Sockets.Num(), integrationData.Profile.BlendProfiles.Num(),
+    integrationData.Profile.SlotGroups.Num(), integrationData.BoneChains.Num(), integrationData.Profile.SkeletonCurves.Num());
+
+  bool errorsOccured = false;
+  // packages of the edited assets, only those are saved
+  TArray<UPackage*> editedPackages;
+
+  for (auto& skeletonPath : skeletonPaths)
+  {
+    USkeleton* skeleton = LoadObject<USkeleton>(nullptr, *skeletonPath);
+    if (!IsValid(skeleton))
+    {
+      UE_LOG(LogTemp, Error, TEXT("Failed to load the skeleton \"%s\"."), *skeletonPath);
+      errorsOccured = true;
+      continue;
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("Applying integration data to \"%s\"..."), *skeleton->GetPathName());
+
+    if (addRootBone && skeleton->GetReferenceSkeleton().FindBoneIndex(TEXT("root")) == INDEX_NONE)
+    {
+      errorsOccured |= !UTTToolboxBlueprintLibrary::AddRootBone(skeleton);
+    }
+
+    errorsOccured |= !applyIntegrationData(integrationData, skeleton);
+    addSkeletonPackages(skeleton, editedPackages);
+  }
+
+  for (auto& ikRigPath : ikRigPaths)
+  {
+    UIKRigDefinition* ikRigDefinition = LoadObject<UIKRigDefinition>(nullptr, *ikRigPath);
+    if (!IsValid(ikRigDefinition))
+    {
+      UE_LOG(LogTemp, Error, TEXT("Failed to load the ik rig \"%s\"."), *ikRigPath);
+      errorsOccured = true;
+      continue;
+    }
+
+    if (integrationData.BoneChains.Num() > 0)
+    {
+      errorsOccured |= !UTTToolboxBlueprintLibrary::AddIKBoneChains(ikRigDefinition, integrationData.BoneChains);
+      editedPackages.AddUnique(ikRigDefinition->GetPackage());
+    }
+  }
+
+  // unchanged packages are skipped through 'bOnlyDirty'
+  if (!noSave && editedPackages.Num() > 0)
+  {
+    if (!UEditorLoadingAndSavingUtils::SavePackages(editedPackages, /*bOnlyDirty*/true))
+    {
+      UE_LOG(LogTemp, Error, TEXT("Failed to save all modified packages."));
+      errorsOccured = true;
+    }
+  }
+
+  return errorsOccured ? 1 : 0;
+}
+
+static TArray<FString> parseAssetList(const TMap<FString, FString>& ParamVals, const TCHAR* Key)
+{
+  TArray<FString> assetPaths;
+  if (const FString* value = ParamVals.Find(Key))
+  {
+    value->ParseIntoArray(assetPaths, TEXT(","), /*InCullEmpty*/true);
+  }
+  return assetPaths;
+}
+
+static bool forEachEntry(const FString& DataPath, const TCHAR* DataTableName, TArrayView<const TCHAR* const> KeyFieldNames, TFunctionRef<bool(const FName&, const CRowEntry&)> Visitor)
+{
+  const FString objectPath = FString::Printf(TEXT("%s/%s.%s"), *DataPath, DataTableName, DataTableName);
+  const UDataTable* dataTable = LoadObject<UDataTable>(nullptr, *objectPath);
+  if (!IsValid(dataTable))
+  {
+    UE_LOG(LogTemp, Warning, TEXT("Data table \"%s\" not found, it will be skipped."), *objectPath);
+    return true;
+  }
+
+  const UScriptStruct* rowStruct = dataTable->GetRowStruct();
+  if (rowStruct == nullptr)
+  {
+    UE_LOG(LogTemp, Error, TEXT("Data table \"%s\" has no row structure."), *objectPath);
+    return false;
+  }
+
+  bool isValid = true;
+  TArray<CRowEntry> entries;
+  for (auto& row : dataTable->GetRowMap())
+  {
+    // a row either describes a single entry or contains a list of entries
+    entries.Reset();
+    collectEntries(rowStruct, row.Value, KeyFieldNames, entries);
+    if (entries.Num() <= 0)
+    {
+      UE_LOG(LogTemp, Error, TEXT("Row \"%s\" of data table \"%s\" (row structure \"%s\") doesn't contain a \"%s\" field."),
+        *row.Key.ToString(), *objectPath, *rowStruct->GetName(), KeyFieldNames[0]);
+      isValid = false;
+      continue;
+    }
+
+    for (auto& entry : entries)
+    {
+      if (!Visitor(row.Key, entry))
+      {
+        UE_LOG(LogTemp, Error, TEXT("Row \"%s\" of data table \"%s\" (row structure \"%s\") is missing required fields or uses unsupported field types."),
+          *row.Key.ToString(), *objectPath, *rowStruct->GetName());
+        isValid = false;
+      }
+    }
+  }
+
+  return isValid;
+}
+
+static void collectEntries(const UStruct* Struct, const uint8* Data, TArrayView<const TCHAR* const> KeyFieldNames, TArray<CRowEntry>& OutEntries)
+{
+  if (findField(Struct, KeyFieldNames) != nullptr)
+  {
+    OutEntries.Add({ Struct, Data });
+    return;
+  }
+
+  // search nested structures and arrays of structures for the entries
+  for (TFieldIterator<FProperty> it(Struct); it; ++it)
+  {
+    if (const FStructProperty* structProperty = CastField<FStructProperty>(*it))
+    {
+      collectEntries(structProperty->Struct, structProperty->ContainerPtrToValuePtr<uint8>(Data), KeyFieldNames, OutEntries);
+    }
+    else if (const FArrayProperty* arrayProperty = CastField<FArrayProperty>(*it))
+    {
+      if (const FStructProperty* innerStructProperty = CastField<FStructProperty>(arrayProperty->Inner))
+      {
+        FScriptArrayHelper arrayHelper(arrayProperty, arrayProperty->ContainerPtrToValuePtr<void>(Data));
+        for (int32 ii = 0; ii < arrayHelper.Num(); ++ii)
+        {
+          collectEntries(innerStructProperty->Struct, arrayHelper.GetRawPtr(ii), KeyFieldNames, OutEntries);
+        }
+      }
+    }
+  }
+}
+
+static const FProperty* findField(const UStruct* Struct, TArrayView<const TCHAR* const> FieldNames)
+{
+  // the field names are ordered by priority
+  for (const TCHAR* fieldName : FieldNames)
+  {
+    const FString normalizedFieldName = normalizeFieldName(fieldName);
+    for (TFieldIterator<FProperty> it(Struct); it; ++it)
+    {
+      // Blueprint structures use internal property names like "BoneName_4_<Guid>", only the authored name is stable
+      if (normalizeFieldName(Struct->GetAuthoredNameForField(*it)) == normalizedFieldName)
+      {
+        return *it;
+      }
+    }
+  }
+
+  return nullptr;
+}
+
+static FString normalizeFieldName(const FString& FieldName)
+{
+  return FieldName.Replace(TEXT(" "), TEXT("")).Replace(TEXT("_"), TEXT("")).ToLower();
+}
+
+static bool getNameValue(const FProperty* Property, const void* Value, FName& OutName)
+{
+  if (const FNameProperty* nameProperty = CastField<FNameProperty>(Property))
+  {
+    OutName = nameProperty->GetPropertyValue(Value);
+    return true;
+  }
+
+  if (const FStrProperty* strProperty = CastField<FStrProperty>(Property))
+  {
+    OutName = FName(*strProperty->GetPropertyValue(Value));
+    return true;
+  }
+
+  if (const FTextProperty* textProperty = CastField<FTextProperty>(Property))
+  {
+    OutName = FName(*textProperty->GetPropertyValue(Value).ToString());
+    return true;
+  }
+
+  return false;
+}
+
+static bool readName(const CRowEntry& Entry, TArrayView<const TCHAR* const> FieldNames, FName& OutName)
+{
+  const FProperty* property = findField(Entry.Struct, FieldNames);
+  return property != nullptr && getNameValue(property, property->ContainerPtrToValuePtr<void>(Entry.Data), OutName);
+}
+
+static bool readNames(const CRowEntry& Entry, TArrayView<const TCHAR* const> FieldNames, TArray<FName>& OutNames)
+{
+  const FProperty* property = findField(Entry.Struct, FieldNames);
+  if (property == nullptr)
+  {
+    return false;
+  }
+
+  // a single name is accepted as well
+  const FArrayProperty* arrayProperty = CastField<FArrayProperty>(property);
+  if (arrayProperty == nullptr)
+  {
+    FName name;
+    if (!getNameValue(property, property->ContainerPtrToValuePtr<void>(Entry.Data), name))
+    {
+      return false;
+    }
+
+    OutNames.Add(name);
+    return true;
+  }
+
+  FScriptArrayHelper arrayHelper(arrayProperty, arrayProperty->ContainerPtrToValuePtr<void>(Entry.Data));
+  for (int32 ii = 0; ii < arrayHelper.Num(); ++ii)
+  {
+    FName name;
+    if (!getNameValue(arrayProperty->Inner, arrayHelper.GetRawPtr(ii), name))
+    {
+      return false;
+    }
+
+    OutNames.Add(name);
+  }
+
+  return true;
+}
+
+static bool readBool(const CRowEntry& Entry, TArrayView<const TCHAR* const> FieldNames, bool& OutValue)
+{
+  const FBoolProperty* boolProperty = CastField<FBoolProperty>(findField(Entry.Struct, FieldNames));
+  if (boolProperty == nullptr)
+  {
+    return false;
+  }
+
+  OutValue = boolProperty->GetPropertyValue_InContainer(Entry.Data);
+  return true;
+}
+
+static bool readTransform(const CRowEntry& Entry, FTransform& OutTransform)
+{
+  const FStructProperty* transformProperty = CastField<FStructProperty>(findField(Entry.Struct, gs_transformFields));
+  if (transformProperty != nullptr && transformProperty->Struct == TBaseStructure<FTransform>::Get())
+  {
+    OutTransform = *transformProperty->ContainerPtrToValuePtr<FTransform>(Entry.Data);
+    return true;
+  }
+
+  // the transform is stored as separate location, rotation and scale fields otherwise, each of them is optional
+  OutTransform = FTransform::Identity;
+
+  const FStructProperty* locationProperty = CastField<FStructProperty>(findField(Entry.Struct, gs_locationFields));
+  if (locationProperty != nullptr && locationProperty->Struct == TBaseStructure<FVector>::Get())
+  {
+    OutTransform.SetTranslation(*locationProperty->ContainerPtrToValuePtr<FVector>(Entry.Data));
+  }
+
+  const FStructProperty* rotationProperty = CastField<FStructProperty>(findField(Entry.Struct, gs_rotationFields));
+  if (rotationProperty != nullptr && rotationProperty->Struct == TBaseStructure<FRotator>::Get())
+  {
+    OutTransform.SetRotation(rotationProperty->ContainerPtrToValuePtr<FRotator>(Entry.Data)->Quaternion());
+  }
+
+  const FStructProperty* scaleProperty = CastField<FStructProperty>(findField(Entry.Struct, gs_scaleFields));
+  if (scaleProperty != nullptr && scaleProperty->Struct == TBaseStructure<FVector>::Get())
+  {
+    OutTransform.SetScale3D(*scaleProperty->ContainerPtrToValuePtr<FVector>(Entry.Data));
+  }
+
+  return true;
+}
+
+static bool readBlendProfileMode(const CRowEntry& Entry, EBlendProfileMode& OutBlendProfileMode)
+{
+  const FProperty* property = findField(Entry.Struct, gs_blendProfileModeFields);
+  if (property == nullptr)
+  {
+    return false;
+  }
+
+  const void* value = property->ContainerPtrToValuePtr<void>(Entry.Data);
+  if (const FEnumProperty* enumProperty = CastField<FEnumProperty>(property))
+  {
+    OutBlendProfileMode = static_cast<EBlendProfileMode>(enumProperty->GetUnderlyingProperty()->GetSignedIntPropertyValue(value));
+    return true;
+  }
+
+  if (const FByteProperty* byteProperty = CastField<FByteProperty>(property))
+  {
+    OutBlendProfileMode = static_cast<EBlendProfileMode>(byteProperty->GetPropertyValue(value));
+    return true;
+  }
+
+  return false;
+}
+
+static bool readBlendValues(const CRowEntry& Entry, TMap<FName, float>& OutBlendValues)
+{
+  const FMapProperty* mapProperty = CastField<FMapProperty>(findField(Entry.Struct, gs_blendValuesFields));
+  const FNumericProperty* valueProperty = mapProperty != nullptr ? CastField<FNumericProperty>(mapProperty->ValueProp) : nullptr;
+  if (valueProperty == nullptr)
+  {
+    return false;
+  }
+
+  // Blueprint structures store floats as double
+  FScriptMapHelper mapHelper(mapProperty, mapProperty->ContainerPtrToValuePtr<void>(Entry.Data));
+  for (int32 ii = 0; ii < mapHelper.GetMaxIndex(); ++ii)
+  {
+    if (!mapHelper.IsValidIndex(ii))
+    {
+      continue;
+    }
+
+    FName boneName;
+    if (!getNameValue(mapProperty->KeyProp, mapHelper.GetKeyPtr(ii), boneName))
+    {
+      return false;
+    }
+
+    const void* value = mapHelper.GetValuePtr(ii);
+    const double blendValue = valueProperty->IsFloatingPoint() ? valueProperty->GetFloatingPointPropertyValue(value) : static_cast<double>(valueProperty->GetSignedIntPropertyValue(value));
+    OutBlendValues.Add(boneName, static_cast<float>(blendValue));
+  }
+
+  return true;
+}
+
+static bool readIntegrationData(const FString& DataPath, CIntegrationData& OutIntegrationData)
+{
+  bool isValid = true;
+
+  isValid &= forEachEntry(DataPath, TEXT("DT_UnweightedBones"), gs_newBoneNameFields, [&OutIntegrationData](const FName& RowName, const CRowEntry& Entry)
+  {
+    FTTNewBone_BP newBone;
+    if (!readName(Entry, gs_newBoneNameFields, newBone.NewBoneName) || !readName(Entry, gs_parentBoneFields, newBone.ParentBone))
+    {
+      return false;
+    }
+
+    // the constraint bone is optional
+    readName(Entry, gs_constraintBoneFields, newBone.ConstraintBone);
+    OutIntegrationData.UnweightedBones.Add(newBone);
+    return true;
+  });
+
+  isValid &= forEachEntry(DataPath, TEXT("DT_VirtualBones"), gs_virtualBoneNameFields, [&OutIntegrationData](const FName& RowName, const CRowEntry& Entry)
+  {
+    FTTVirtualBone_BP virtualBone;
+    if (!readName(Entry, gs_virtualBoneNameFields, virtualBone.VirtualBoneName) || !readName(Entry, gs_sourceBoneFields, virtualBone.SourceBoneName) ||
+        !readName(Entry, gs_targetBoneFields, virtualBone.TargetBoneName))
+    {
+      return false;
+    }
+
+    OutIntegrationData.Profile.VirtualBones.Add(virtualBone);
+    return true;
+  });
+
+  isValid &= forEachEntry(DataPath, TEXT("DT_Sockets"), gs_socketNameFields, [&OutIntegrationData](const FName& RowName, const CRowEntry& Entry)
+  {
+    FTTSocket_BP socket;
+    if (!readName(Entry, gs_socketNameFields, socket.SocketName) || !readName(Entry, gs_socketBoneFields, socket.BoneName) || !readTransform(Entry, socket.RelativeTransform))
+    {
+      return false;
+    }
+
+    OutIntegrationData.Profile.Sockets.Add(socket);
+    return true;
+  });
+
+  // the blend profile name is taken from the row name, if the entry doesn't contain a name field
+  isValid &= forEachEntry(DataPath, TEXT("DT_BlendProfiles"), gs_blendValuesFields, [&OutIntegrationData](const FName& RowName, const CRowEntry& Entry)
+  {
+    FTTBlendProfile_BP blendProfile;
+    if (!readBlendValues(Entry, blendProfile.BlendValues))
+    {
+      return false;
+    }
+
+    // older blend profile structures don't contain a mode
+    readBlendProfileMode(Entry, blendProfile.BlendProfileMode);
+
+    FName blendProfileName = RowName;
+    readName(Entry, gs_blendProfileNameFields, blendProfileName);
+    OutIntegrationData.Profile.BlendProfiles.Add(blendProfileName, blendProfile);
+    return true;
+  });
+
+  isValid &= forEachEntry(DataPath, TEXT("DT_SlotGroups"), gs_slotGroupNameFields, [&OutIntegrationData](const FName& RowName, const CRowEntry& Entry)
+  {
+    FTTMontageSlotGroup slotGroup;
+    if (!readName(Entry, gs_slotGroupNameFields, slotGroup.GroupName))
+    {
+      return false;
+    }
+
+    // a slot group without slots is valid
+    readNames(Entry, gs_slotNamesFields, slotGroup.SlotNames);
+    OutIntegrationData.Profile.SlotGroups.Add(slotGroup);
+    return true;
+  });
+
+  isValid &= forEachEntry(DataPath, TEXT("DT_IKBoneChains"), gs_chainNameFields, [&OutIntegrationData](const FName& RowName, const CRowEntry& Entry)
+  {
+    FBoneChain_BP boneChain;
+    if (!readName(Entry, gs_chainNameFields, boneChain.ChainName) || !readName(Entry, gs_startBoneFields, boneChain.StartBone) ||
+        !readName(Entry, gs_endBoneFields, boneChain.EndBone))
+    {
+      return false;
+    }
+
+    // chains without ik goal are valid
+    readName(Entry, gs_ikGoalNameFields, boneChain.IKGoalName);
+    OutIntegrationData.BoneChains.Add(boneChain);
+    return true;
+  });
+
+  // an entry can contain a single curve name or a list of curve names, the curve flags are optional and apply to all of them
+  isValid &= forEachEntry(DataPath, TEXT("DT_SkeletonCurves"), gs_curveNameFields, [&OutIntegrationData](const FName& RowName, const CRowEntry& Entry)
+  {
+    TArray<FName> curveNames;
+    if (!readNames(Entry, gs_curveNameFields, curveNames))
+    {
+      return false;
+    }
+
+    FTTSkeletonCurve_BP skeletonCurve;
+    readBool(Entry, gs_materialFields, skeletonCurve.Material);
+    readBool(Entry, gs_morphTargetFields, skeletonCurve.MorphTarget);
+    for (const FName& curveName : curveNames)
+    {
+      skeletonCurve.CurveName = curveName;
+      OutIntegrationData.Profile.SkeletonCurves.Add(skeletonCurve);
+    }
+    return true;
+  });
+
+  return isValid;
+}
+
+static bool applyIntegrationData(const CIntegrationData& IntegrationData, USkeleton* Skeleton)
+{
+  bool errorsOccured = false;
+
+  // new bones are added first, the other integration data might reference them
+  if (IntegrationData.UnweightedBones.Num() > 0)
+  {
+    TArray<FTTNewBone_BP> missingBones;
+    for (auto& unweightedBone : IntegrationData.UnweightedBones)
+    {
+      if (Skeleton->GetReferenceSkeleton().FindBoneIndex(unweightedBone.NewBoneName) == INDEX_NONE)
+      {
+        missingBones.Add(unweightedBone);
+      }
+    }
+
+    if (missingBones.Num() > 0)
+    {
+      errorsOccured |= !UTTToolboxBlueprintLibrary::AddUnweightedBone(missingBones, Skeleton);
+    }
+  }
+
+  // all skeleton edits are applied at once, saving is done for all edited packages afterwards
+  errorsOccured |= !UTTToolboxBlueprintLibrary::ApplyIntegrationProfile(Skeleton, IntegrationData.Profile, /*Save*/false);
+
+  return !errorsOccured;
+}
+
+static void addSkeletonPackages(USkeleton* Skeleton, TArray<UPackage*>& OutPackages)
+{
+  OutPackages.AddUnique(Skeleton->GetPackage());
+
+  // new bones modify the skeletal meshes, which were loaded while adding the bones
+  for (auto& skeletalMeshPath : CSkeletalMeshRegistry::Get().GetSkeletalMeshPaths(Skeleton))
+  {
+    if (USkeletalMesh* skeletalMesh = Cast<USkeletalMesh>(skeletalMeshPath.ResolveObject()))
+    {
+      OutPackages.AddUnique(skeletalMesh->GetPackage());
+    }
+  }
+}
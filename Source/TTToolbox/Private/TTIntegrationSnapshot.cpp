@@ -0,0 +1,283 @@
+// The MIT License (MIT)
+// ---------------------
+// 
+// Copyright 2022 Achim Turan (https://www.instagram.com/tuatec/)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all copies or
+// substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "TTIntegrationSnapshot.h"
+
+// Unreal Engine includes
+#include "Animation/Skeleton.h"
+#include "Animation/BlendProfile.h"
+#include "Engine/SkeletalMeshSocket.h"
+#include "Rig/IKRigDefinition.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/NameAsStringProxyArchive.h"
+#include "JsonObjectConverter.h"
+
+// helper functions
+static FArchive& operator<<(FArchive& Archive, FTTVirtualBone_BP& VirtualBone);
+static FArchive& operator<<(FArchive& Archive, FTTSocket_BP& Socket);
+static FArchive& operator<<(FArchive& Archive, FTTSkeletonCurve_BP& SkeletonCurve);
+static FArchive& operator<<(FArchive& Archive, FTTBlendProfile_BP& BlendProfile);
+static FArchive& operator<<(FArchive& Archive, FTTMontageSlotGroup& SlotGroup);
+static FArchive& operator<<(FArchive& Archive, FBoneChain_BP& BoneChain);
+
+void CIntegrationSnapshotFile::Capture(USkeleton* Skeleton, const UIKRigDefinition* IKRigDefinition, FTTIntegrationSnapshot& OutSnapshot)
+{
+  OutSnapshot = FTTIntegrationSnapshot();
+
+  if (IsValid(Skeleton))
+  {
+    FTTIntegrationProfile& profile = OutSnapshot.Profile;
+
+    profile.VirtualBones.Reserve(Skeleton->GetVirtualBones().Num());
+    for (auto& virtualBone : Skeleton->GetVirtualBones())
+    {
+      FTTVirtualBone_BP& virtualBoneBP = profile.VirtualBones.AddDefaulted_GetRef();
+      virtualBoneBP.VirtualBoneName = virtualBone.VirtualBoneName;
+      virtualBoneBP.SourceBoneName = virtualBone.SourceBoneName;
+      virtualBoneBP.TargetBoneName = virtualBone.TargetBoneName;
+    }
+
+    profile.Sockets.Reserve(Skeleton->Sockets.Num());
+    for (auto socket : Skeleton->Sockets)
+    {
+      if (IsValid(socket))
+      {
+        FTTSocket_BP& socketBP = profile.Sockets.AddDefaulted_GetRef();
+        socketBP.BoneName = socket->BoneName;
+        socketBP.SocketName = socket->SocketName;
+        socketBP.RelativeTransform = FTransform(socket->RelativeRotation, socket->RelativeLocation, socket->RelativeScale);
+      }
+    }
+
+    TArray<FName> skeletonCurveNames;
+    Skeleton->GetCurveMetaDataNames(skeletonCurveNames);
+    profile.SkeletonCurves.Reserve(skeletonCurveNames.Num());
+    for (auto& skeletonCurveName : skeletonCurveNames)
+    {
+      FTTSkeletonCurve_BP& skeletonCurveBP = profile.SkeletonCurves.AddDefaulted_GetRef();
+      skeletonCurveBP.CurveName = skeletonCurveName;
+      if (const FCurveMetaData* curveMetaData = Skeleton->GetCurveMetaData(skeletonCurveName))
+      {
+        skeletonCurveBP.Material = curveMetaData->Type.bMaterial;
+        skeletonCurveBP.MorphTarget = curveMetaData->Type.bMorphtarget;
+      }
+    }
+
+    for (auto& blendProfile : Skeleton->BlendProfiles)
+    {
+      if (!blendProfile)
+      {
+        continue;
+      }
+
+      FTTBlendProfile_BP& blendProfileBP = profile.BlendProfiles.Add(blendProfile->GetFName());
+      blendProfileBP.BlendProfileMode = blendProfile->GetMode();
+      blendProfileBP.BlendValues.Reserve(blendProfile->ProfileEntries.Num());
+      for (auto& entry : blendProfile->ProfileEntries)
+      {
+        blendProfileBP.BlendValues.Add(entry.BoneReference.BoneName, entry.BlendScale);
+      }
+    }
+
+    for (auto& slotGroup : Skeleton->GetSlotGroups())
+    {
+      FTTMontageSlotGroup& slotGroupBP = profile.SlotGroups.AddDefaulted_GetRef();
+      slotGroupBP.GroupName = slotGroup.GroupName;
+      slotGroupBP.SlotNames = slotGroup.SlotNames;
+    }
+  }
+
+  if (IsValid(IKRigDefinition))
+  {
+    OutSnapshot.IKBoneChains.Reserve(IKRigDefinition->GetRetargetChains().Num());
+    for (auto& boneChain : IKRigDefinition->GetRetargetChains())
+    {
+      OutSnapshot.IKBoneChains.Add(FBoneChain_BP(boneChain));
+    }
+  }
+}
+
+bool CIntegrationSnapshotFile::Save(const FTTIntegrationSnapshot& Snapshot, const FString& FilePath)
+{
+  if (isJson(FilePath))
+  {
+    FString jsonString;
+    if (!FJsonObjectConverter::UStructToJsonObjectString(Snapshot, jsonString))
+    {
+      UE_LOG(LogTemp, Error, TEXT("Failed to convert the integration snapshot to JSON."));
+      return false;
+    }
+
+    if (!FFileHelper::SaveStringToFile(jsonString, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+    {
+      UE_LOG(LogTemp, Error, TEXT("Failed to write the integration snapshot to \"%s\"."), *FilePath);
+      return false;
+    }
+
+    return true;
+  }
+
+  TUniquePtr<FArchive> fileArchive(IFileManager::Get().CreateFileWriter(*FilePath));
+  if (!fileArchive.IsValid())
+  {
+    UE_LOG(LogTemp, Error, TEXT("Failed to create the file \"%s\"."), *FilePath);
+    return false;
+  }
+
+  uint32 magic = Magic;
+  uint32 version = LatestVersion;
+  *fileArchive << magic;
+  *fileArchive << version;
+
+  // names are stored as strings, the name table of the archive is not available in plain files
+  FNameAsStringProxyArchive archive(*fileArchive);
+  serialize(archive, version, const_cast<FTTIntegrationSnapshot&>(Snapshot));
+
+  if (!fileArchive->Close())
+  {
+    UE_LOG(LogTemp, Error, TEXT("Failed to write the integration snapshot to \"%s\"."), *FilePath);
+    return false;
+  }
+
+  return true;
+}
+
+bool CIntegrationSnapshotFile::Load(const FString& FilePath, FTTIntegrationSnapshot& OutSnapshot)
+{
+  OutSnapshot = FTTIntegrationSnapshot();
+
+  if (isJson(FilePath))
+  {
+    FString jsonString;
+    if (!FFileHelper::LoadFileToString(jsonString, *FilePath))
+    {
+      UE_LOG(LogTemp, Error, TEXT("Failed to read the integration snapshot \"%s\"."), *FilePath);
+      return false;
+    }
+
+    if (!FJsonObjectConverter::JsonObjectStringToUStruct(jsonString, &OutSnapshot))
+    {
+      UE_LOG(LogTemp, Error, TEXT("Failed to parse the integration snapshot \"%s\"."), *FilePath);
+      return false;
+    }
+
+    return true;
+  }
+
+  TUniquePtr<FArchive> fileArchive(IFileManager::Get().CreateFileReader(*FilePath));
+  if (!fileArchive.IsValid())
+  {
+    UE_LOG(LogTemp, Error, TEXT("Failed to open the file \"%s\"."), *FilePath);
+    return false;
+  }
+
+  uint32 magic = 0;
+  uint32 version = 0;
+  *fileArchive << magic;
+  *fileArchive << version;
+  if (magic != Magic)
+  {
+    UE_LOG(LogTemp, Error, TEXT("\"%s\" is not an integration snapshot."), *FilePath);
+    return false;
+  }
+
+  if (version < InitialVersion || version > LatestVersion)
+  {
+    UE_LOG(LogTemp, Error, TEXT("The integration snapshot \"%s\" has the unsupported version %u (latest supported version %u)."), *FilePath, version, static_cast<uint32>(LatestVersion));
+    return false;
+  }
+
+  FNameAsStringProxyArchive archive(*fileArchive);
+  serialize(archive, version, OutSnapshot);
+
+  if (fileArchive->IsError())
+  {
+    UE_LOG(LogTemp, Error, TEXT("The integration snapshot \"%s\" is corrupt."), *FilePath);
+    OutSnapshot = FTTIntegrationSnapshot();
+    return false;
+  }
+
+  return true;
+}
+
+bool CIntegrationSnapshotFile::isJson(const FString& FilePath)
+{
+  return FPaths::GetExtension(FilePath).Equals(TEXT("json"), ESearchCase::IgnoreCase);
+}
+
+void CIntegrationSnapshotFile::serialize(FArchive& Archive, uint32 Version, FTTIntegrationSnapshot& Snapshot)
+{
+  FTTIntegrationProfile& profile = Snapshot.Profile;
+  Archive << profile.VirtualBones;
+  Archive << profile.Sockets;
+  if (Version >= SkeletonCurveFlags)
+  {
+    Archive << profile.SkeletonCurves;
+  }
+  else
+  {
+    // older snapshots only store the curve names
+    TArray<FName> skeletonCurveNames;
+    Archive << skeletonCurveNames;
+    for (auto& skeletonCurveName : skeletonCurveNames)
+    {
+      profile.SkeletonCurves.AddDefaulted_GetRef().CurveName = skeletonCurveName;
+    }
+  }
+  Archive << profile.BlendProfiles;
+  Archive << profile.SlotGroups;
+  Archive << profile.OverwriteBlendProfiles;
+  Archive << Snapshot.IKBoneChains;
+}
+
+static FArchive& operator<<(FArchive& Archive, FTTVirtualBone_BP& VirtualBone)
+{
+  return Archive << VirtualBone.VirtualBoneName << VirtualBone.SourceBoneName << VirtualBone.TargetBoneName;
+}
+
+static FArchive& operator<<(FArchive& Archive, FTTSocket_BP& Socket)
+{
+  return Archive << Socket.BoneName << Socket.SocketName << Socket.RelativeTransform;
+}
+
+static FArchive& operator<<(FArchive& Archive, FTTSkeletonCurve_BP& SkeletonCurve)
+{
+  return Archive << SkeletonCurve.CurveName << SkeletonCurve.Material << SkeletonCurve.MorphTarget;
+}
+
+static FArchive& operator<<(FArchive& Archive, FTTBlendProfile_BP& BlendProfile)
+{
+  uint8 blendProfileMode = static_cast<uint8>(BlendProfile.BlendProfileMode);
+  Archive << blendProfileMode;
+  BlendProfile.BlendProfileMode = static_cast<EBlendProfileMode>(blendProfileMode);
+  return Archive << BlendProfile.BlendValues;
+}
+
+static FArchive& operator<<(FArchive& Archive, FTTMontageSlotGroup& SlotGroup)
+{
+  return Archive << SlotGroup.GroupName << SlotGroup.SlotNames;
+}
+
+static FArchive& operator<<(FArchive& Archive, FBoneChain_BP& BoneChain)
+{
+  return Archive << BoneChain.ChainName << BoneChain.StartBone << BoneChain.EndBone << BoneChain.IKGoalName;
+}
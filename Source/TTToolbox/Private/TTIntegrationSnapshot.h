@@ -0,0 +1,56 @@
+// The MIT License (MIT)
+// ---------------------
+// 
+// Copyright 2022 Achim Turan (https://www.instagram.com/tuatec/)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all copies or
+// substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TTToolboxTypes.h"
+
+// forward declarations
+class USkeleton;
+class UIKRigDefinition;
+
+// Reads and writes integration snapshots. Files with the extension ".json" are stored as JSON,
+// all other files use a compact binary format starting with a magic number and a version.
+struct CIntegrationSnapshotFile
+{
+  static constexpr uint32 Magic = 0x53495454; // "TTIS"
+
+  enum EVersion : uint32
+  {
+    InitialVersion = 1,
+    // the skeleton curves are stored with their material and morph target flags
+    SkeletonCurveFlags = 2,
+
+    // add new versions above this line
+    VersionPlusOne,
+    LatestVersion = VersionPlusOne - 1
+  };
+
+  // collects the integration state of the 'Skeleton' and the optional 'IKRigDefinition'
+  static void Capture(USkeleton* Skeleton, const UIKRigDefinition* IKRigDefinition, FTTIntegrationSnapshot& OutSnapshot);
+
+  static bool Save(const FTTIntegrationSnapshot& Snapshot, const FString& FilePath);
+  static bool Load(const FString& FilePath, FTTIntegrationSnapshot& OutSnapshot);
+
+private:
+  static bool isJson(const FString& FilePath);
+  static void serialize(FArchive& Archive, uint32 Version, FTTIntegrationSnapshot& Snapshot);
+};
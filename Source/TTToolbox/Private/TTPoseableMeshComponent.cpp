@@ -20,9 +20,24 @@
 
 #include "TTPoseableMeshComponent.h"
 
+// Unreal Engine includes
+#include "Async/ParallelFor.h"
+#include "Engine/World.h"
+
+// helper function prototypes
+static void onWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+static void encodePose(const TArray<FTransform>& Transforms, CPoseSnapshot& OutPoseSnapshot);
+static void decodePose(CPoseSnapshot& PoseSnapshot);
+static uint16 quantizeRotationComponent(float Value);
+static float dequantizeRotationComponent(uint16 Value);
+
+// components with a deferred pose update, flushed after the actor tick of their world
+static TArray<TWeakObjectPtr<UTTPoseableMeshComponent>> gs_pendingPoseUpdates;
+static FDelegateHandle gs_onWorldPostActorTickHandle;
+
 void UTTPoseableMeshComponent::SetBoneLocalTransformByName(const FName& BoneName, const FTransform& InTransform)
 {
-  if (!GetSkinnedAsset() || !RequiredBones.IsValid())
+  if (!canSetBoneTransforms())
   {
     return;
   }
@@ -31,30 +46,505 @@ void UTTPoseableMeshComponent::SetBoneLocalTransformByName(const FName& BoneName
   if (boneIndex >= 0 && boneIndex < BoneSpaceTransforms.Num())
   {
     BoneSpaceTransforms[boneIndex] = InTransform;
-    MarkRefreshTransformDirty();
+    markBoneDirty(boneIndex);
+    markRefreshTransformDirty();
+  }
+}
+
+void UTTPoseableMeshComponent::SetBoneLocalTransformsByName(const TArray<FName>& BoneNames, const TArray<FTransform>& Transforms, bool UpdatePoseImmediately)
+{
+  if (BoneNames.Num() != Transforms.Num())
+  {
+    UE_LOG(LogTemp, Error, TEXT("Called \"SetBoneLocalTransformsByName\" with %d bone names and %d transforms."), BoneNames.Num(), Transforms.Num());
+    return;
+  }
+
+  if (!canSetBoneTransforms())
+  {
+    return;
+  }
+
+  for (int32 index = 0; index < BoneNames.Num(); index++)
+  {
+    const int32 boneIndex = GetBoneIndex(BoneNames[index]);
+    if (BoneSpaceTransforms.IsValidIndex(boneIndex))
+    {
+      BoneSpaceTransforms[boneIndex] = Transforms[index];
+      markBoneDirty(boneIndex);
+    }
+  }
+
+  markRefreshTransformDirty();
+
+  if (UpdatePoseImmediately)
+  {
+    UpdatePose();
+  }
+}
+
+void UTTPoseableMeshComponent::SetBoneLocalTransformsByIndex(const TArray<int32>& BoneIndices, const TArray<FTransform>& Transforms, bool UpdatePoseImmediately)
+{
+  if (BoneIndices.Num() != Transforms.Num())
+  {
+    UE_LOG(LogTemp, Error, TEXT("Called \"SetBoneLocalTransformsByIndex\" with %d bone indices and %d transforms."), BoneIndices.Num(), Transforms.Num());
+    return;
+  }
+
+  if (!canSetBoneTransforms())
+  {
+    return;
+  }
+
+  for (int32 index = 0; index < BoneIndices.Num(); index++)
+  {
+    if (BoneSpaceTransforms.IsValidIndex(BoneIndices[index]))
+    {
+      BoneSpaceTransforms[BoneIndices[index]] = Transforms[index];
+      markBoneDirty(BoneIndices[index]);
+    }
+  }
+
+  markRefreshTransformDirty();
+
+  if (UpdatePoseImmediately)
+  {
+    UpdatePose();
   }
 }
 
+TArray<int32> UTTPoseableMeshComponent::GetBoneIndices(const TArray<FName>& BoneNames)
+{
+  TArray<int32> boneIndices;
+  boneIndices.Reserve(BoneNames.Num());
+  for (auto& boneName : BoneNames)
+  {
+    boneIndices.Add(GetBoneIndex(boneName));
+  }
+
+  return boneIndices;
+}
+
 void UTTPoseableMeshComponent::UpdatePose()
 {
-  // Can't do anything without a SkeletalMesh
-  if (!GetSkinnedAsset())
+  if (!canUpdatePose())
   {
     return;
   }
 
-  // Do nothing more if no bones in skeleton.
-  if (GetNumComponentSpaceTransforms() == 0)
+  // the pose is evaluated together with the other deferred components after the actor tick of the world
+  if (DeferPoseUpdate && GetWorld() != nullptr)
+  {
+    if (!m_isPoseUpdatePending)
+    {
+      m_isPoseUpdatePending = true;
+      gs_pendingPoseUpdates.Add(this);
+
+      if (!gs_onWorldPostActorTickHandle.IsValid())
+      {
+        gs_onWorldPostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddStatic(&onWorldPostActorTick);
+      }
+    }
+    return;
+  }
+
+  fillPose();
+  finalizePose();
+}
+
+void UTTPoseableMeshComponent::RefreshBoneTransforms(FActorComponentTickFunction* TickFunction)
+{
+  // a pending deferred update evaluates the whole pose on a worker after the actor tick, refreshing it here would do the same work twice
+  if (m_isPoseUpdatePending)
+  {
+    return;
+  }
+
+  if (!UpdateDirtyBonesOnly)
+  {
+    Super::RefreshBoneTransforms(TickFunction);
+    return;
+  }
+
+  // The tick refresh of the base class always fills all bones and updates the bounds. With dirty bone tracking
+  // only the bones changed since the last 'UpdatePose' are evaluated, nothing is done if the pose is up to date.
+  if (!canUpdatePose())
   {
     return;
   }
 
+  if (!m_requiresFullFill && m_dirtyBones.Num() == BoneSpaceTransforms.Num() && m_dirtyBones.Find(true) == INDEX_NONE)
+  {
+    return;
+  }
+
+  fillPose();
+  finalizePose();
+}
+
+bool UTTPoseableMeshComponent::CapturePose(const FName& PoseName)
+{
+  if (!canSetBoneTransforms() || PoseName.IsNone())
+  {
+    UE_LOG(LogTemp, Error, TEXT("Called \"CapturePose\" without skinned asset or with invalid \"PoseName\" (\"None\")."));
+    return false;
+  }
+
+  CPoseSnapshot& poseSnapshot = m_poseSnapshots.FindOrAdd(PoseName);
+  poseSnapshot.SkinnedAsset = GetSkinnedAsset();
+  encodePose(BoneSpaceTransforms, poseSnapshot);
+
+  return true;
+}
+
+bool UTTPoseableMeshComponent::ApplyPose(const FName& PoseName, bool UpdatePoseImmediately)
+{
+  const TArray<FTransform>* pose = findDecodedPose(PoseName);
+  if (pose == nullptr)
+  {
+    UE_LOG(LogTemp, Error, TEXT("Called \"ApplyPose\" with pose \"%s\", which doesn't exist or doesn't match the skinned asset."), *PoseName.ToString());
+    return false;
+  }
+
+  // the decoded transforms are copied as a whole
+  FMemory::Memcpy(BoneSpaceTransforms.GetData(), pose->GetData(), pose->Num() * sizeof(FTransform));
+  setAllBoneTransforms(UpdatePoseImmediately);
+
+  return true;
+}
+
+bool UTTPoseableMeshComponent::BlendPoses(const FName& PoseNameA, const FName& PoseNameB, float Alpha, bool UpdatePoseImmediately)
+{
+  const TArray<FTransform>* poseA = findDecodedPose(PoseNameA);
+  const TArray<FTransform>* poseB = findDecodedPose(PoseNameB);
+  if (poseA == nullptr || poseB == nullptr)
+  {
+    UE_LOG(LogTemp, Error, TEXT("Called \"BlendPoses\" with pose \"%s\" or \"%s\", which doesn't exist or doesn't match the skinned asset."), *PoseNameA.ToString(), *PoseNameB.ToString());
+    return false;
+  }
+
+  // FTransform::Blend is vectorized, the rotations are blended with a normalized lerp
+  const float alpha = FMath::Clamp(Alpha, 0.0f, 1.0f);
+  for (int32 boneIndex = 0; boneIndex < BoneSpaceTransforms.Num(); boneIndex++)
+  {
+    BoneSpaceTransforms[boneIndex].Blend((*poseA)[boneIndex], (*poseB)[boneIndex], alpha);
+  }
+  setAllBoneTransforms(UpdatePoseImmediately);
+
+  return true;
+}
+
+bool UTTPoseableMeshComponent::HasPose(const FName& PoseName) const
+{
+  return m_poseSnapshots.Contains(PoseName);
+}
+
+bool UTTPoseableMeshComponent::RemovePose(const FName& PoseName)
+{
+  return m_poseSnapshots.Remove(PoseName) > 0;
+}
+
+void UTTPoseableMeshComponent::ClearPoses()
+{
+  m_poseSnapshots.Empty();
+}
+
+void UTTPoseableMeshComponent::FlushPendingPoseUpdates(UWorld* World)
+{
+  // collect the pending components of the world, components of other worlds stay pending
+  TArray<UTTPoseableMeshComponent*> components;
+  for (int32 index = gs_pendingPoseUpdates.Num() - 1; index >= 0; index--)
+  {
+    UTTPoseableMeshComponent* component = gs_pendingPoseUpdates[index].Get();
+    if (component != nullptr && World != nullptr && component->GetWorld() != World)
+    {
+      continue;
+    }
+
+    gs_pendingPoseUpdates.RemoveAtSwap(index);
+    if (component != nullptr)
+    {
+      component->m_isPoseUpdatePending = false;
+      // the skinned asset might have been changed since the update was requested
+      if (component->canUpdatePose())
+      {
+        components.Add(component);
+      }
+    }
+  }
+
+  // the component space transforms of each component are only written by its own worker
+  ParallelFor(components.Num(), [&components](int32 Index)
+  {
+    components[Index]->fillPose();
+  });
+
+  // flipping the buffers, child transforms, bounds and render state need to be updated on the game thread
+  for (auto component : components)
+  {
+    component->finalizePose();
+  }
+}
+
+void UTTPoseableMeshComponent::ShutdownPendingPoseUpdates()
+{
+  if (gs_onWorldPostActorTickHandle.IsValid())
+  {
+    FWorldDelegates::OnWorldPostActorTick.Remove(gs_onWorldPostActorTickHandle);
+    gs_onWorldPostActorTickHandle.Reset();
+  }
+  gs_pendingPoseUpdates.Empty();
+}
+
+const TArray<FTransform>* UTTPoseableMeshComponent::findDecodedPose(const FName& PoseName)
+{
+  CPoseSnapshot* poseSnapshot = m_poseSnapshots.Find(PoseName);
+  if (poseSnapshot == nullptr || !canSetBoneTransforms() || poseSnapshot->SkinnedAsset.Get() != GetSkinnedAsset() || poseSnapshot->Num() != BoneSpaceTransforms.Num())
+  {
+    return nullptr;
+  }
+
+  if (poseSnapshot->DecodedTransforms.Num() != poseSnapshot->Num())
+  {
+    decodePose(*poseSnapshot);
+  }
+
+  return &poseSnapshot->DecodedTransforms;
+}
+
+void UTTPoseableMeshComponent::setAllBoneTransforms(bool UpdatePoseImmediately)
+{
+  // all bones changed, so the dirty bone tracking is skipped for the next update
+  m_requiresFullFill = true;
+  markRefreshTransformDirty();
+
+  if (UpdatePoseImmediately)
+  {
+    UpdatePose();
+  }
+}
+
+bool UTTPoseableMeshComponent::canUpdatePose() const
+{
+  // Can't do anything without a SkeletalMesh
+  if (!GetSkinnedAsset())
+  {
+    return false;
+  }
+
+  // Do nothing more if no bones in skeleton.
+  return GetNumComponentSpaceTransforms() > 0;
+}
+
+void UTTPoseableMeshComponent::fillPose()
+{
   // We need the mesh space bone transforms now for renderer to get delta from ref pose:
-  FillComponentSpaceTransforms();
+  m_maxTranslationDelta = 0.0f;
+  m_isFullFill = !UpdateDirtyBonesOnly || !fillDirtyComponentSpaceTransforms(m_maxTranslationDelta);
+  if (m_isFullFill)
+  {
+    FillComponentSpaceTransforms();
+    m_dirtyBones.Init(false, BoneSpaceTransforms.Num());
+    m_requiresFullFill = false;
+  }
+}
+
+void UTTPoseableMeshComponent::finalizePose()
+{
   FinalizeBoneTransform();
 
   UpdateChildTransforms();
-  UpdateBounds();
+
+  // small changes don't need to update the bounds every time
+  m_boundsTranslationDelta += m_maxTranslationDelta;
+  if (m_isFullFill || m_boundsTranslationDelta >= BoundsUpdateThreshold)
+  {
+    UpdateBounds();
+    m_boundsTranslationDelta = 0.0f;
+  }
   MarkRenderTransformDirty();
   MarkRenderDynamicDataDirty();
 }
+
+void UTTPoseableMeshComponent::markRefreshTransformDirty()
+{
+  // with dirty bone tracking the tick refresh checks the dirty bones itself (see 'RefreshBoneTransforms')
+  if (!UpdateDirtyBonesOnly)
+  {
+    MarkRefreshTransformDirty();
+  }
+}
+
+bool UTTPoseableMeshComponent::canSetBoneTransforms() const
+{
+  return GetSkinnedAsset() && RequiredBones.IsValid();
+}
+
+void UTTPoseableMeshComponent::markBoneDirty(int32 BoneIndex)
+{
+  if (m_dirtyBones.Num() != BoneSpaceTransforms.Num())
+  {
+    // the bones changed (e.g. new skinned asset), so the component space transforms need to be filled completely
+    m_dirtyBones.Init(false, BoneSpaceTransforms.Num());
+    m_requiresFullFill = true;
+  }
+
+  m_dirtyBones[BoneIndex] = true;
+}
+
+bool UTTPoseableMeshComponent::fillDirtyComponentSpaceTransforms(float& OutMaxTranslationDelta)
+{
+  const int32 numBones = BoneSpaceTransforms.Num();
+  if (m_requiresFullFill || !RequiredBones.IsValid() || m_dirtyBones.Num() != numBones || GetNumComponentSpaceTransforms() != numBones)
+  {
+    return false;
+  }
+
+  // nothing changed since the last update
+  const int32 firstDirtyBoneIndex = m_dirtyBones.Find(true);
+  if (firstDirtyBoneIndex == INDEX_NONE)
+  {
+    return true;
+  }
+
+  // with double buffering the editable buffer is one update behind, so it starts from the latest transforms
+  const TArray<FTransform>& readComponentSpaceTransforms = GetComponentSpaceTransforms();
+  TArray<FTransform>& componentSpaceTransforms = GetEditableComponentSpaceTransforms();
+  if (componentSpaceTransforms.GetData() != readComponentSpaceTransforms.GetData())
+  {
+    FMemory::Memcpy(componentSpaceTransforms.GetData(), readComponentSpaceTransforms.GetData(), numBones * sizeof(FTransform));
+  }
+
+  // the required bones are sorted parents first, so the dirty flag is propagated to the children while iterating
+  const FReferenceSkeleton& refSkeleton = GetSkinnedAsset()->GetRefSkeleton();
+  float maxTranslationDeltaSquared = 0.0f;
+  for (const FBoneIndexType requiredBoneIndex : RequiredBones.GetBoneIndicesArray())
+  {
+    const int32 boneIndex = requiredBoneIndex;
+    if (boneIndex < firstDirtyBoneIndex)
+    {
+      continue;
+    }
+
+    const int32 parentIndex = refSkeleton.GetParentIndex(boneIndex);
+    const bool isParentDirty = parentIndex != INDEX_NONE && m_dirtyBones[parentIndex];
+    if (!m_dirtyBones[boneIndex] && !isParentDirty)
+    {
+      continue;
+    }
+    m_dirtyBones[boneIndex] = true;
+
+    const FVector previousTranslation = componentSpaceTransforms[boneIndex].GetTranslation();
+    if (parentIndex == INDEX_NONE)
+    {
+      componentSpaceTransforms[boneIndex] = BoneSpaceTransforms[boneIndex];
+    }
+    else
+    {
+      FTransform::Multiply(&componentSpaceTransforms[boneIndex], &BoneSpaceTransforms[boneIndex], &componentSpaceTransforms[parentIndex]);
+    }
+
+    maxTranslationDeltaSquared = FMath::Max(maxTranslationDeltaSquared, static_cast<float>(FVector::DistSquared(previousTranslation, componentSpaceTransforms[boneIndex].GetTranslation())));
+  }
+
+  m_dirtyBones.Init(false, numBones);
+  bNeedToFlipSpaceBaseBuffers = true;
+
+  OutMaxTranslationDelta = FMath::Sqrt(maxTranslationDeltaSquared);
+  return true;
+}
+
+static void onWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+  if (gs_pendingPoseUpdates.Num() > 0)
+  {
+    UTTPoseableMeshComponent::FlushPendingPoseUpdates(World);
+  }
+}
+
+static void encodePose(const TArray<FTransform>& Transforms, CPoseSnapshot& OutPoseSnapshot)
+{
+  const int32 numBones = Transforms.Num();
+  OutPoseSnapshot.QuantizedRotations.SetNumUninitialized(numBones * 3);
+  OutPoseSnapshot.Translations.SetNumUninitialized(numBones);
+  OutPoseSnapshot.Scales.SetNumUninitialized(numBones);
+  // the decoded transforms of a previous capture are outdated
+  OutPoseSnapshot.DecodedTransforms.Reset();
+
+  for (int32 boneIndex = 0; boneIndex < numBones; boneIndex++)
+  {
+    const FQuat4f rotation = FQuat4f(Transforms[boneIndex].GetRotation().GetNormalized());
+    const float components[4] = { rotation.X, rotation.Y, rotation.Z, rotation.W };
+
+    // smallest three: the largest component is dropped and reconstructed, the other components are within [-1/sqrt(2), 1/sqrt(2)]
+    int32 largestIndex = 0;
+    for (int32 ii = 1; ii < 4; ii++)
+    {
+      if (FMath::Abs(components[ii]) > FMath::Abs(components[largestIndex]))
+      {
+        largestIndex = ii;
+      }
+    }
+
+    // q and -q are the same rotation, so the rotation is stored with a positive largest component
+    const float sign = components[largestIndex] < 0.0f ? -1.0f : 1.0f;
+
+    uint16* quantizedRotation = &OutPoseSnapshot.QuantizedRotations[boneIndex * 3];
+    int32 quantizedIndex = 0;
+    for (int32 ii = 0; ii < 4; ii++)
+    {
+      if (ii != largestIndex)
+      {
+        quantizedRotation[quantizedIndex++] = quantizeRotationComponent(components[ii] * sign);
+      }
+    }
+
+    // the index of the largest component is stored in the unused highest bits of the first two components
+    quantizedRotation[0] |= static_cast<uint16>((largestIndex >> 1) << 15);
+    quantizedRotation[1] |= static_cast<uint16>((largestIndex & 1) << 15);
+
+    OutPoseSnapshot.Translations[boneIndex] = FVector3f(Transforms[boneIndex].GetTranslation());
+    OutPoseSnapshot.Scales[boneIndex] = FVector3f(Transforms[boneIndex].GetScale3D());
+  }
+}
+
+static void decodePose(CPoseSnapshot& PoseSnapshot)
+{
+  const int32 numBones = PoseSnapshot.Num();
+  PoseSnapshot.DecodedTransforms.SetNumUninitialized(numBones);
+
+  for (int32 boneIndex = 0; boneIndex < numBones; boneIndex++)
+  {
+    const uint16* quantizedRotation = &PoseSnapshot.QuantizedRotations[boneIndex * 3];
+    const int32 largestIndex = ((quantizedRotation[0] >> 15) << 1) | (quantizedRotation[1] >> 15);
+
+    float components[4];
+    float sumOfSquares = 0.0f;
+    int32 quantizedIndex = 0;
+    for (int32 ii = 0; ii < 4; ii++)
+    {
+      if (ii != largestIndex)
+      {
+        components[ii] = dequantizeRotationComponent(quantizedRotation[quantizedIndex++] & 0x7fff);
+        sumOfSquares += components[ii] * components[ii];
+      }
+    }
+    components[largestIndex] = FMath::Sqrt(FMath::Max(1.0f - sumOfSquares, 0.0f));
+
+    FQuat rotation(components[0], components[1], components[2], components[3]);
+    rotation.Normalize();
+
+    PoseSnapshot.DecodedTransforms[boneIndex] = FTransform(rotation, FVector(PoseSnapshot.Translations[boneIndex]), FVector(PoseSnapshot.Scales[boneIndex]));
+  }
+}
+
+static uint16 quantizeRotationComponent(float Value)
+{
+  // maps [-1/sqrt(2), 1/sqrt(2)] to 15 bits [0, 32767]
+  const float normalizedValue = FMath::Clamp(Value * static_cast<float>(UE_SQRT_2), -1.0f, 1.0f);
+  return static_cast<uint16>(FMath::RoundToInt32((normalizedValue * 0.5f + 0.5f) * 32767.0f));
+}
+
+static float dequantizeRotationComponent(uint16 Value)
+{
+  return ((static_cast<float>(Value) / 32767.0f) * 2.0f - 1.0f) * static_cast<float>(UE_INV_SQRT_2);
+}
@@ -0,0 +1,217 @@
+// The MIT License (MIT)
+// ---------------------
+// 
+// Copyright 2022 Achim Turan (https://www.instagram.com/tuatec/)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all copies or
+// substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "TTSkeletalMeshRegistry.h"
+
+// Unreal Engine includes
+#include "Animation/Skeleton.h"
+#include "Engine/SkeletalMesh.h"
+#include "AssetRegistry/ARFilter.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+
+static TUniquePtr<CSkeletalMeshRegistry> gs_skeletalMeshRegistry;
+
+CSkeletalMeshRegistry& CSkeletalMeshRegistry::Get()
+{
+  if (!gs_skeletalMeshRegistry.IsValid())
+  {
+    gs_skeletalMeshRegistry.Reset(new CSkeletalMeshRegistry());
+
+    IAssetRegistry& assetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+    gs_skeletalMeshRegistry->m_onAssetAddedHandle = assetRegistry.OnAssetAdded().AddRaw(gs_skeletalMeshRegistry.Get(), &CSkeletalMeshRegistry::onAssetAdded);
+    gs_skeletalMeshRegistry->m_onAssetRemovedHandle = assetRegistry.OnAssetRemoved().AddRaw(gs_skeletalMeshRegistry.Get(), &CSkeletalMeshRegistry::onAssetRemoved);
+    gs_skeletalMeshRegistry->m_onAssetRenamedHandle = assetRegistry.OnAssetRenamed().AddRaw(gs_skeletalMeshRegistry.Get(), &CSkeletalMeshRegistry::onAssetRenamed);
+    gs_skeletalMeshRegistry->m_onAssetUpdatedHandle = assetRegistry.OnAssetUpdated().AddRaw(gs_skeletalMeshRegistry.Get(), &CSkeletalMeshRegistry::onAssetUpdated);
+  }
+
+  return *gs_skeletalMeshRegistry;
+}
+
+void CSkeletalMeshRegistry::Shutdown()
+{
+  gs_skeletalMeshRegistry.Reset();
+}
+
+CSkeletalMeshRegistry::~CSkeletalMeshRegistry()
+{
+  // the asset registry might be unloaded already during engine shutdown
+  if (FAssetRegistryModule* assetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>(TEXT("AssetRegistry")))
+  {
+    IAssetRegistry& assetRegistry = assetRegistryModule->Get();
+    assetRegistry.OnAssetAdded().Remove(m_onAssetAddedHandle);
+    assetRegistry.OnAssetRemoved().Remove(m_onAssetRemovedHandle);
+    assetRegistry.OnAssetRenamed().Remove(m_onAssetRenamedHandle);
+    assetRegistry.OnAssetUpdated().Remove(m_onAssetUpdatedHandle);
+  }
+}
+
+TArray<FSoftObjectPath> CSkeletalMeshRegistry::GetSkeletalMeshPaths(const USkeleton* Skeleton)
+{
+  check(IsValid(Skeleton));
+
+  if (!m_isIndexBuilt)
+  {
+    buildIndex();
+  }
+
+  const FString skeletonString = FAssetData(Skeleton).GetExportTextName();
+  if (const TArray<FSoftObjectPath>* skeletalMeshPaths = m_skeletalMeshesPerSkeleton.Find(skeletonString))
+  {
+    return *skeletalMeshPaths;
+  }
+
+  return TArray<FSoftObjectPath>();
+}
+
+TArray<USkeletalMesh*> CSkeletalMeshRegistry::LoadSkeletalMeshes(const USkeleton* Skeleton, int32 BatchSize)
+{
+  const TArray<FSoftObjectPath> skeletalMeshPaths = GetSkeletalMeshPaths(Skeleton);
+  BatchSize = FMath::Max(BatchSize, 1);
+
+  TArray<USkeletalMesh*> skeletalMeshes;
+  skeletalMeshes.Reserve(skeletalMeshPaths.Num());
+
+  // the handles keep the loaded skeletal meshes alive until all batches are loaded
+  TArray<TSharedPtr<FStreamableHandle>> streamableHandles;
+
+  for (int32 batchStart = 0; batchStart < skeletalMeshPaths.Num(); batchStart += BatchSize)
+  {
+    const int32 batchNum = FMath::Min(BatchSize, skeletalMeshPaths.Num() - batchStart);
+    TArray<FSoftObjectPath> batchPaths(skeletalMeshPaths.GetData() + batchStart, batchNum);
+
+    TSharedPtr<FStreamableHandle> streamableHandle = m_streamableManager.RequestAsyncLoad(MoveTemp(batchPaths), FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority);
+    if (!streamableHandle.IsValid())
+    {
+      continue;
+    }
+    streamableHandle->WaitUntilComplete();
+
+    TArray<UObject*> loadedAssets;
+    streamableHandle->GetLoadedAssets(loadedAssets);
+    for (UObject* loadedAsset : loadedAssets)
+    {
+      // the registry tags of modified skeletal meshes might be outdated
+      USkeletalMesh* skeletalMesh = Cast<USkeletalMesh>(loadedAsset);
+      if (IsValid(skeletalMesh) && skeletalMesh->GetSkeleton() == Skeleton)
+      {
+        skeletalMeshes.Add(skeletalMesh);
+      }
+    }
+
+    streamableHandles.Add(MoveTemp(streamableHandle));
+  }
+
+  for (auto& streamableHandle : streamableHandles)
+  {
+    streamableHandle->ReleaseHandle();
+  }
+
+  return skeletalMeshes;
+}
+
+void CSkeletalMeshRegistry::buildIndex()
+{
+  m_skeletalMeshesPerSkeleton.Reset();
+  m_skeletonPerSkeletalMesh.Reset();
+
+  FARFilter filter;
+  filter.ClassPaths.Add(USkeletalMesh::StaticClass()->GetClassPathName());
+  filter.bRecursiveClasses = true;
+
+  IAssetRegistry& assetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+  TArray<FAssetData> assets;
+  assetRegistry.GetAssets(filter, assets);
+
+  for (auto& asset : assets)
+  {
+    addSkeletalMesh(asset);
+  }
+
+  m_isIndexBuilt = true;
+}
+
+void CSkeletalMeshRegistry::addSkeletalMesh(const FAssetData& AssetData)
+{
+  // an already registered skeletal mesh might have been assigned to another skeleton or none at all
+  const FSoftObjectPath skeletalMeshPath = AssetData.GetSoftObjectPath();
+  removeSkeletalMesh(skeletalMeshPath);
+
+  FString skeletonString;
+  if (!AssetData.GetTagValue(USkeletalMesh::GetSkeletonMemberName(), skeletonString) || skeletonString.IsEmpty())
+  {
+    return;
+  }
+
+  m_skeletalMeshesPerSkeleton.FindOrAdd(skeletonString).Add(skeletalMeshPath);
+  m_skeletonPerSkeletalMesh.Add(skeletalMeshPath, MoveTemp(skeletonString));
+}
+
+void CSkeletalMeshRegistry::removeSkeletalMesh(const FSoftObjectPath& SkeletalMeshPath)
+{
+  FString skeletonString;
+  if (!m_skeletonPerSkeletalMesh.RemoveAndCopyValue(SkeletalMeshPath, skeletonString))
+  {
+    return;
+  }
+
+  if (TArray<FSoftObjectPath>* skeletalMeshPaths = m_skeletalMeshesPerSkeleton.Find(skeletonString))
+  {
+    skeletalMeshPaths->RemoveSingleSwap(SkeletalMeshPath);
+    if (skeletalMeshPaths->IsEmpty())
+    {
+      m_skeletalMeshesPerSkeleton.Remove(skeletonString);
+    }
+  }
+}
+
+void CSkeletalMeshRegistry::onAssetAdded(const FAssetData& AssetData)
+{
+  // the index is built with all known assets on the first request, no need to track assets before
+  if (m_isIndexBuilt && AssetData.IsInstanceOf(USkeletalMesh::StaticClass()))
+  {
+    addSkeletalMesh(AssetData);
+  }
+}
+
+void CSkeletalMeshRegistry::onAssetRemoved(const FAssetData& AssetData)
+{
+  if (m_isIndexBuilt && AssetData.IsInstanceOf(USkeletalMesh::StaticClass()))
+  {
+    removeSkeletalMesh(AssetData.GetSoftObjectPath());
+  }
+}
+
+void CSkeletalMeshRegistry::onAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+  if (m_isIndexBuilt && AssetData.IsInstanceOf(USkeletalMesh::StaticClass()))
+  {
+    removeSkeletalMesh(FSoftObjectPath(OldObjectPath));
+    addSkeletalMesh(AssetData);
+  }
+}
+
+void CSkeletalMeshRegistry::onAssetUpdated(const FAssetData& AssetData)
+{
+  // the skeleton tag changes if a skeletal mesh gets assigned to another skeleton and is saved or reimported
+  if (m_isIndexBuilt && AssetData.IsInstanceOf(USkeletalMesh::StaticClass()))
+  {
+    addSkeletalMesh(AssetData);
+  }
+}
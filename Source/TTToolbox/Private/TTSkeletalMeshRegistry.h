@@ -0,0 +1,78 @@
+// The MIT License (MIT)
+// ---------------------
+// 
+// Copyright 2022 Achim Turan (https://www.instagram.com/tuatec/)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all copies or
+// substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/StreamableManager.h"
+
+// forward declarations
+class USkeleton;
+class USkeletalMesh;
+struct FAssetData;
+
+// Index of the skeletal meshes per skeleton, which is built once out of the "Skeleton" asset registry tag
+// and kept up to date through the asset registry events. Looking up the skeletal meshes of a skeleton
+// doesn't load any asset. Loading is done on request through the streamable manager in bounded batches,
+// the caller is blocked until all batches are loaded.
+class CSkeletalMeshRegistry
+{
+public:
+  // returns the registry, the registry is created and registered at the asset registry on the first call
+  static CSkeletalMeshRegistry& Get();
+
+  // unregisters from the asset registry events and destroys the registry, called on module shutdown
+  static void Shutdown();
+
+  ~CSkeletalMeshRegistry();
+
+  // returns the paths of all skeletal meshes referencing the skeleton, without loading any asset
+  TArray<FSoftObjectPath> GetSkeletalMeshPaths(const USkeleton* Skeleton);
+
+  // Loads all skeletal meshes referencing the skeleton and blocks until they are loaded. The loads are requested
+  // in batches of 'BatchSize' assets and each batch is waited for, which limits the number of in flight loads
+  // but doesn't make the loading lazy. Skeletal meshes that were reassigned to another skeleton in memory are skipped.
+  TArray<USkeletalMesh*> LoadSkeletalMeshes(const USkeleton* Skeleton, int32 BatchSize = 32);
+
+private:
+  CSkeletalMeshRegistry() = default;
+
+  void buildIndex();
+  void addSkeletalMesh(const FAssetData& AssetData);
+  void removeSkeletalMesh(const FSoftObjectPath& SkeletalMeshPath);
+
+  void onAssetAdded(const FAssetData& AssetData);
+  void onAssetRemoved(const FAssetData& AssetData);
+  void onAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+  void onAssetUpdated(const FAssetData& AssetData);
+
+  // skeleton (export text name) -> skeletal meshes
+  TMap<FString, TArray<FSoftObjectPath>> m_skeletalMeshesPerSkeleton;
+  // skeletal mesh -> skeleton (export text name), used to remove skeletal meshes
+  TMap<FSoftObjectPath, FString> m_skeletonPerSkeletalMesh;
+  bool m_isIndexBuilt = false;
+
+  FStreamableManager m_streamableManager;
+
+  FDelegateHandle m_onAssetAddedHandle;
+  FDelegateHandle m_onAssetRemovedHandle;
+  FDelegateHandle m_onAssetRenamedHandle;
+  FDelegateHandle m_onAssetUpdatedHandle;
+};
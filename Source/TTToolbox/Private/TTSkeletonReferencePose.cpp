@@ -0,0 +1,255 @@
+// The MIT License (MIT)
+// ---------------------
+// 
+// Copyright 2022 Achim Turan (https://www.instagram.com/tuatec/)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all copies or
+// substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "TTSkeletonReferencePose.h"
+
+// Unreal Engine includes
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+
+void CSkeletonPoseBuffer::SetNum(int32 NumBones)
+{
+  Rotations.SetNum(NumBones);
+  Translations.SetNum(NumBones);
+  Scales.SetNum(NumBones);
+}
+
+void CSkeletonPoseBuffer::SetTransform(int32 BoneIndex, const FTransform& Transform)
+{
+  Rotations[BoneIndex] = Transform.GetRotation();
+  Translations[BoneIndex] = Transform.GetTranslation();
+  Scales[BoneIndex] = Transform.GetScale3D();
+}
+
+FTransform CSkeletonPoseBuffer::GetTransform(int32 BoneIndex) const
+{
+  return FTransform(Rotations[BoneIndex], Translations[BoneIndex], Scales[BoneIndex]);
+}
+
+// calculates the world space transform of a single bone, the world space transform of the parent needs to be valid
+static FORCEINLINE void composeBone(const CSkeletonPoseBuffer& LocalSpace, int32 BoneIndex, int32 ParentIndex, CSkeletonPoseBuffer& OutWorldSpace)
+{
+  if (ParentIndex == INDEX_NONE)
+  {
+    OutWorldSpace.Rotations[BoneIndex] = LocalSpace.Rotations[BoneIndex];
+    OutWorldSpace.Translations[BoneIndex] = LocalSpace.Translations[BoneIndex];
+    OutWorldSpace.Scales[BoneIndex] = LocalSpace.Scales[BoneIndex];
+    return;
+  }
+
+  checkSlow(ParentIndex < BoneIndex);
+
+  const VectorRegister4Double localRotation = VectorLoad(&LocalSpace.Rotations[BoneIndex].X);
+  const VectorRegister4Double localTranslation = VectorLoadFloat3_W0(&LocalSpace.Translations[BoneIndex].X);
+  const VectorRegister4Double localScale = VectorLoadFloat3_W0(&LocalSpace.Scales[BoneIndex].X);
+  const VectorRegister4Double parentRotation = VectorLoad(&OutWorldSpace.Rotations[ParentIndex].X);
+  const VectorRegister4Double parentTranslation = VectorLoadFloat3_W0(&OutWorldSpace.Translations[ParentIndex].X);
+  const VectorRegister4Double parentScale = VectorLoadFloat3_W0(&OutWorldSpace.Scales[ParentIndex].X);
+
+  const VectorRegister4Double zero = VectorZeroDouble();
+  if (VectorAnyLesserThan(localScale, zero) || VectorAnyLesserThan(parentScale, zero))
+  {
+    // negative scales need the matrix based composition of FTransform to stay identical
+    OutWorldSpace.SetTransform(BoneIndex, LocalSpace.GetTransform(BoneIndex) * OutWorldSpace.GetTransform(ParentIndex));
+    return;
+  }
+
+  // same math as FTransform::Multiply(local, parent) without the FTransform (un)packing
+  const VectorRegister4Double rotation = VectorQuaternionMultiply2(parentRotation, localRotation);
+  const VectorRegister4Double scaledTranslation = VectorMultiply(parentScale, localTranslation);
+  const VectorRegister4Double translation = VectorAdd(VectorQuaternionRotateVector(parentRotation, scaledTranslation), parentTranslation);
+  const VectorRegister4Double scale = VectorMultiply(localScale, parentScale);
+
+  VectorStore(rotation, &OutWorldSpace.Rotations[BoneIndex].X);
+  VectorStoreFloat3(translation, &OutWorldSpace.Translations[BoneIndex].X);
+  VectorStoreFloat3(scale, &OutWorldSpace.Scales[BoneIndex].X);
+}
+
+void CSkeletonPoseBuffer::ComposeWorldSpace(const TArray<int32>& ParentIndices, CSkeletonPoseBuffer& OutWorldSpace, int32 FirstBoneIndex) const
+{
+  const int32 numBones = Num();
+  check(ParentIndices.Num() == numBones);
+  OutWorldSpace.SetNum(numBones);
+
+  for (int32 ii = FirstBoneIndex; ii < numBones; ++ii)
+  {
+    composeBone(*this, ii, ParentIndices[ii], OutWorldSpace);
+  }
+}
+
+void CSkeletonPoseBuffer::ComposeDirtyWorldSpace(const TArray<int32>& ParentIndices, TBitArray<>& DirtyBones, CSkeletonPoseBuffer& OutWorldSpace, int32 FirstBoneIndex) const
+{
+  const int32 numBones = Num();
+  check(ParentIndices.Num() == numBones && DirtyBones.Num() == numBones);
+  OutWorldSpace.SetNum(numBones);
+
+  for (int32 ii = FirstBoneIndex; ii < numBones; ++ii)
+  {
+    const int32 parentIndex = ParentIndices[ii];
+    if (DirtyBones[ii] || (parentIndex != INDEX_NONE && DirtyBones[parentIndex]))
+    {
+      composeBone(*this, ii, parentIndex, OutWorldSpace);
+      DirtyBones[ii] = true;
+    }
+  }
+}
+
+CSkeletonReferencePose::CSkeletonReferencePose(const FReferenceSkeleton& ReferenceSkeleton)
+  : m_referenceSkeleton(ReferenceSkeleton)
+{
+  const int32 numBones = m_referenceSkeleton.GetNum();
+  m_parentIndices.SetNumUninitialized(numBones);
+  m_localSpacePoses.SetNum(numBones);
+  for (int32 ii = 0; ii < numBones; ++ii)
+  {
+    m_parentIndices[ii] = m_referenceSkeleton.GetParentIndex(ii);
+    m_localSpacePoses.SetTransform(ii, m_referenceSkeleton.GetRefBonePose()[ii]);
+  }
+
+  m_localSpacePoses.ComposeWorldSpace(m_parentIndices, m_worldSpacePoses);
+  m_dirtyBones.Init(false, numBones);
+}
+
+void CSkeletonReferencePose::SetBonePose(const FName& BoneName, const FTransform& Transform, EBonePoseSpaces Space)
+{
+  int32 boneIndex = m_referenceSkeleton.FindBoneIndex(BoneName);
+  if (boneIndex == INDEX_NONE)
+  {
+    UE_LOG(LogTemp, Error, TEXT("The bone name \"%s\" is not present to calculate the local and world transforms. Please create an issue here https://github.com/tuatec/TTToolbox/issues."), *BoneName.ToString());
+    return;
+  }
+
+  if (Space == EBonePoseSpaces::Local)
+  {
+    m_localSpacePoses.SetTransform(boneIndex, Transform);
+  }
+  else
+  {
+    // the world space transform of the parent is needed to calculate the local space pose
+    calculateWorldSpaceTransforms();
+
+    const int32 parentIndex = m_parentIndices[boneIndex];
+    const FTransform ParentTransformWS = parentIndex != INDEX_NONE ? m_worldSpacePoses.GetTransform(parentIndex) : FTransform::Identity;
+    m_localSpacePoses.SetTransform(boneIndex, Transform.GetRelativeTransform(ParentTransformWS));
+  }
+
+  markDirty(boneIndex);
+}
+
+FTransform CSkeletonReferencePose::GetRefBonePose(const FName& BoneName, EBonePoseSpaces Space)
+{
+  int32 boneIndex = m_referenceSkeleton.FindBoneIndex(BoneName);
+  if (boneIndex == INDEX_NONE)
+  {
+    return FTransform::Identity;
+  }
+
+  if (Space == EBonePoseSpaces::Local)
+  {
+    return m_localSpacePoses.GetTransform(boneIndex);
+  }
+
+  calculateWorldSpaceTransforms();
+  return m_worldSpacePoses.GetTransform(boneIndex);
+}
+
+void CSkeletonReferencePose::markDirty(int32 BoneIndex)
+{
+  m_dirtyBones[BoneIndex] = true;
+  m_firstDirtyBone = m_firstDirtyBone == INDEX_NONE ? BoneIndex : FMath::Min(m_firstDirtyBone, BoneIndex);
+}
+
+void CSkeletonReferencePose::calculateWorldSpaceTransforms()
+{
+  if (m_firstDirtyBone == INDEX_NONE)
+  {
+    return;
+  }
+
+  // only the dirty bones and their children are recalculated
+  m_localSpacePoses.ComposeDirtyWorldSpace(m_parentIndices, m_dirtyBones, m_worldSpacePoses, m_firstDirtyBone);
+
+  m_dirtyBones.SetRange(0, m_dirtyBones.Num(), false);
+  m_firstDirtyBone = INDEX_NONE;
+}
+
+// micro benchmark to compare the former per bone FTransform composition with the structure of arrays composition
+static void benchmarkPoseComposer(const TArray<FString>& Args)
+{
+  const int32 numBones = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 1000;
+  const int32 numIterations = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 1000;
+
+  // generate a random hierarchy in hierarchy order
+  FRandomStream randomStream(42);
+  TArray<int32> parentIndices;
+  TArray<FTransform> localSpacePosesAoS;
+  CSkeletonPoseBuffer localSpacePosesSoA;
+  parentIndices.SetNumUninitialized(numBones);
+  localSpacePosesAoS.SetNum(numBones);
+  localSpacePosesSoA.SetNum(numBones);
+  for (int32 ii = 0; ii < numBones; ++ii)
+  {
+    parentIndices[ii] = ii == 0 ? INDEX_NONE : randomStream.RandHelper(ii);
+    const FTransform transform(FQuat(randomStream.GetUnitVector(), randomStream.FRandRange(-PI, PI)), randomStream.GetUnitVector() * randomStream.FRandRange(0.f, 50.f));
+    localSpacePosesAoS[ii] = transform;
+    localSpacePosesSoA.SetTransform(ii, transform);
+  }
+
+  // former implementation: per bone FTransform composition with a temporary array per call
+  TArray<FTransform> worldSpacePosesAoS;
+  double startTime = FPlatformTime::Seconds();
+  for (int32 iteration = 0; iteration < numIterations; ++iteration)
+  {
+    TArray<bool> processed;
+    processed.SetNumZeroed(localSpacePosesAoS.Num());
+    worldSpacePosesAoS.SetNum(localSpacePosesAoS.Num());
+    for (int32 ii = 0; ii < numBones; ++ii)
+    {
+      const int32 parentIndex = parentIndices[ii];
+      worldSpacePosesAoS[ii] = parentIndex != INDEX_NONE ? localSpacePosesAoS[ii] * worldSpacePosesAoS[parentIndex] : localSpacePosesAoS[ii];
+      processed[ii] = true;
+    }
+  }
+  const double aosSeconds = FPlatformTime::Seconds() - startTime;
+
+  // structure of arrays composition with a reused buffer
+  CSkeletonPoseBuffer worldSpacePosesSoA;
+  startTime = FPlatformTime::Seconds();
+  for (int32 iteration = 0; iteration < numIterations; ++iteration)
+  {
+    localSpacePosesSoA.ComposeWorldSpace(parentIndices, worldSpacePosesSoA);
+  }
+  const double soaSeconds = FPlatformTime::Seconds() - startTime;
+
+  // verify both implementations produce the same results
+  double maxError = 0.0;
+  for (int32 ii = 0; ii < numBones; ++ii)
+  {
+    maxError = FMath::Max(maxError, FVector::Dist(worldSpacePosesAoS[ii].GetTranslation(), worldSpacePosesSoA.Translations[ii]));
+  }
+
+  UE_LOG(LogTemp, Display, TEXT("Pose composer benchmark (%i bones, %i iterations): per bone = %.3f ms, structure of arrays = %.3f ms (x%.2f), max translation error = %g"),
+    numBones, numIterations, aosSeconds * 1000.0, soaSeconds * 1000.0, soaSeconds > 0.0 ? aosSeconds / soaSeconds : 0.0, maxError);
+}
+
+static FAutoConsoleCommand gs_benchmarkPoseComposerCommand(
+  TEXT("TTToolbox.BenchmarkPoseComposer"),
+  TEXT("Compares the per bone FTransform composition with the structure of arrays composition. Usage: TTToolbox.BenchmarkPoseComposer [NumBones=1000] [Iterations=1000]"),
+  FConsoleCommandWithArgsDelegate::CreateStatic(&benchmarkPoseComposer));
@@ -0,0 +1,84 @@
+// The MIT License (MIT)
+// ---------------------
+// 
+// Copyright 2022 Achim Turan (https://www.instagram.com/tuatec/)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all copies or
+// substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ReferenceSkeleton.h"
+
+// Structure of arrays storage for bone transforms. Rotations, translations and scales are stored in separate
+// streams, which allows to compose whole hierarchies with vector registers without (un)packing FTransforms.
+// The buffer is meant to be reused to avoid allocations per composition.
+struct CSkeletonPoseBuffer
+{
+  void SetNum(int32 NumBones);
+  int32 Num() const { return Rotations.Num(); }
+
+  void SetTransform(int32 BoneIndex, const FTransform& Transform);
+  FTransform GetTransform(int32 BoneIndex) const;
+
+  // Calculates world (component) space transforms out of this local space pose for all bones starting at 'FirstBoneIndex'.
+  // The bones need to be in hierarchy order (parents before children), the world space transforms of the parents
+  // of 'FirstBoneIndex' and following bones need to be valid already.
+  void ComposeWorldSpace(const TArray<int32>& ParentIndices, CSkeletonPoseBuffer& OutWorldSpace, int32 FirstBoneIndex = 0) const;
+
+  // Same as 'ComposeWorldSpace' but only recalculates the bones flagged in 'DirtyBones' and their children.
+  // The flags of all recalculated children are set in 'DirtyBones' as well.
+  void ComposeDirtyWorldSpace(const TArray<int32>& ParentIndices, TBitArray<>& DirtyBones, CSkeletonPoseBuffer& OutWorldSpace, int32 FirstBoneIndex = 0) const;
+
+  TArray<FQuat> Rotations;
+  TArray<FVector> Translations;
+  TArray<FVector> Scales;
+};
+
+//! @todo @ffs check if the engine class could be used here
+// Changing bone poses only marks the bone as dirty, the world space transforms of the dirty bones
+// and their children are recalculated lazily when a world space transform is requested.
+struct CSkeletonReferencePose
+{
+  CSkeletonReferencePose(const FReferenceSkeleton& ReferenceSkeleton);
+
+  enum class EBonePoseSpaces : uint8
+  {
+    // Local (bone) space 
+    Local,
+    // World (component) space
+    World
+  };
+
+  void SetBonePose(const FName& BoneName, const FTransform& Transform, EBonePoseSpaces Space = EBonePoseSpaces::Local);
+
+  FTransform GetRefBonePose(const FName& BoneName, EBonePoseSpaces Space = EBonePoseSpaces::Local);
+
+private:
+  void calculateWorldSpaceTransforms();
+  void markDirty(int32 BoneIndex);
+
+  const FReferenceSkeleton& m_referenceSkeleton;
+  TArray<int32> m_parentIndices;
+
+  CSkeletonPoseBuffer m_localSpacePoses;
+  CSkeletonPoseBuffer m_worldSpacePoses;
+
+  // bones whose local space pose changed since the last world space calculation
+  TBitArray<> m_dirtyBones;
+  // smallest dirty bone index, INDEX_NONE if all world space transforms are up to date
+  int32 m_firstDirtyBone = INDEX_NONE;
+};
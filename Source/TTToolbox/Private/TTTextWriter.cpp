@@ -0,0 +1,134 @@
+// The MIT License (MIT)
+// ---------------------
+// 
+// Copyright 2022 Achim Turan (https://www.instagram.com/tuatec/)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all copies or
+// substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "TTTextWriter.h"
+
+// Unreal Engine includes
+#include "HAL/FileManager.h"
+#include "Runtime/Launch/Resources/Version.h"
+
+CTextWriter::CTextWriter(int32 EstimatedLength, FArchive* Archive)
+  : m_archive(Archive)
+{
+  // the buffer never grows beyond the flush threshold when streaming
+  m_text.Reserve(Archive != nullptr ? FMath::Min(EstimatedLength, FlushThreshold + 1024) : EstimatedLength);
+}
+
+CTextWriter& CTextWriter::AppendQuoted(const FName& Name)
+{
+  m_text.AppendChar(TEXT('"'));
+  Name.AppendString(m_text);
+  m_text.AppendChar(TEXT('"'));
+  return flushIfNeeded();
+}
+
+CTextWriter& CTextWriter::AppendFloat(double Value)
+{
+  // avoid "-0.0"
+  if (Value == 0.0)
+  {
+    Value = 0.0;
+  }
+
+  const int32 start = m_text.Len();
+  m_text.Appendf(TEXT("%f"), Value);
+
+  // remove trailing zeros, but keep one fractional digit
+  int32 decimalPoint = INDEX_NONE;
+  for (int32 ii = start; ii < m_text.Len(); ++ii)
+  {
+    if (m_text[ii] == TEXT('.'))
+    {
+      decimalPoint = ii;
+      break;
+    }
+  }
+
+  if (decimalPoint != INDEX_NONE)
+  {
+    int32 newLength = m_text.Len();
+    while (newLength > decimalPoint + 2 && m_text[newLength - 1] == TEXT('0'))
+    {
+      --newLength;
+    }
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION <= 3
+    m_text.LeftInline(newLength, /*bAllowShrinking*/false);
+#else
+    m_text.LeftInline(newLength, EAllowShrinking::No);
+#endif
+  }
+
+  return flushIfNeeded();
+}
+
+CTextWriter& CTextWriter::AppendVector(const FVector& Vector)
+{
+  Append(TEXT("X=")).AppendFloat(Vector.X);
+  Append(TEXT(",Y=")).AppendFloat(Vector.Y);
+  Append(TEXT(",Z=")).AppendFloat(Vector.Z);
+  return *this;
+}
+
+void CTextWriter::Flush()
+{
+  if (m_archive == nullptr || m_text.IsEmpty())
+  {
+    return;
+  }
+
+  const FTCHARToUTF8 utf8Text(*m_text, m_text.Len());
+  m_archive->Serialize(const_cast<ANSICHAR*>(utf8Text.Get()), utf8Text.Length());
+  m_text.Reset();
+}
+
+void CTextWriter::LogChunked() const
+{
+  int32 start = 0;
+  while (start < m_text.Len())
+  {
+    int32 length = FMath::Min(MaxLogLineLength, m_text.Len() - start);
+
+    // split after the last ',' of the chunk, so entries are not torn apart
+    if (start + length < m_text.Len())
+    {
+      for (int32 ii = start + length - 1; ii > start; --ii)
+      {
+        if (m_text[ii] == TEXT(','))
+        {
+          length = ii - start + 1;
+          break;
+        }
+      }
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("%s"), *FString(length, *m_text + start));
+    start += length;
+  }
+}
+
+TUniquePtr<FArchive> CTextWriter::CreateFileArchive(const FString& FilePath)
+{
+  TUniquePtr<FArchive> archive(IFileManager::Get().CreateFileWriter(*FilePath));
+  if (!archive.IsValid())
+  {
+    UE_LOG(LogTemp, Error, TEXT("Failed to create the file \"%s\"."), *FilePath);
+  }
+  return archive;
+}
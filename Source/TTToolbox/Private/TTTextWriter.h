@@ -0,0 +1,77 @@
+// The MIT License (MIT)
+// ---------------------
+// 
+// Copyright 2022 Achim Turan (https://www.instagram.com/tuatec/)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all copies or
+// substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Text writer for the Dump* functions. The text is appended in place into a pre-sized buffer, numbers are formatted
+// without temporary strings. If an archive is given, the buffer is streamed to the archive (UTF-8) whenever it exceeds
+// 'FlushThreshold' characters, so the memory usage stays constant for arbitrarily large dumps.
+class CTextWriter
+{
+public:
+  static constexpr int32 FlushThreshold = 64 * 1024;
+  // maximum number of characters per log line, longer text is split into multiple lines
+  static constexpr int32 MaxLogLineLength = 4096;
+
+  explicit CTextWriter(int32 EstimatedLength, FArchive* Archive = nullptr);
+
+  CTextWriter& Append(TCHAR Character) { m_text.AppendChar(Character); return flushIfNeeded(); }
+  CTextWriter& Append(const TCHAR* Text) { m_text.Append(Text); return flushIfNeeded(); }
+  CTextWriter& Append(FStringView Text) { m_text.Append(Text.GetData(), Text.Len()); return flushIfNeeded(); }
+  CTextWriter& Append(const FName& Name) { Name.AppendString(m_text); return flushIfNeeded(); }
+
+  // appends the quoted name, e.g. "Name"
+  CTextWriter& AppendQuoted(const FName& Name);
+
+  // appends the number in the same format as FString::SanitizeFloat (at least one fractional digit, no trailing zeros)
+  CTextWriter& AppendFloat(double Value);
+
+  // appends X=..,Y=..,Z=..
+  CTextWriter& AppendVector(const FVector& Vector);
+
+  // writes the buffered text to the archive
+  void Flush();
+
+  bool IsStreaming() const { return m_archive != nullptr; }
+
+  // the (remaining) buffered text, the complete text if not streaming
+  const FString& GetText() const { return m_text; }
+
+  // logs the buffered text in lines of at most 'MaxLogLineLength' characters, lines are split after a ',' if possible
+  void LogChunked() const;
+
+  // creates a file archive for 'FilePath', returns nullptr and logs an error if the file can't be created
+  static TUniquePtr<FArchive> CreateFileArchive(const FString& FilePath);
+
+private:
+  CTextWriter& flushIfNeeded()
+  {
+    if (m_archive != nullptr && m_text.Len() >= FlushThreshold)
+    {
+      Flush();
+    }
+    return *this;
+  }
+
+  FString m_text;
+  FArchive* m_archive = nullptr;
+};
@@ -20,6 +20,11 @@
 
 #include "TTToolbox.h"
 
+// TTToolbox includes
+#include "TTSkeletalMeshRegistry.h"
+#include "TTAnimRecompressionQueue.h"
+#include "TTPoseableMeshComponent.h"
+
 #define LOCTEXT_NAMESPACE "FTTToolboxModule"
 
 void FTTToolboxModule::StartupModule()
@@ -31,6 +36,10 @@ void FTTToolboxModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+
+	CSkeletalMeshRegistry::Shutdown();
+	CAnimRecompressionQueue::Shutdown();
+	UTTPoseableMeshComponent::ShutdownPendingPoseUpdates();
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -39,20 +39,80 @@
 #include "ControlRig.h"
 
 #include "Animation/BlendProfile.h"
+#include "Animation/AnimData/IAnimationDataModel.h"
+#include "Animation/AnimData/IAnimationDataController.h"
+
+#include "Async/ParallelFor.h"
+#include "Misc/ScopedSlowTask.h"
+
+#include "ScopedTransaction.h"
+#include "FileHelpers.h"
 
 #if WITH_EDITOR
 #include "HAL/PlatformApplicationMisc.h"
 #endif
 
+// TTToolbox includes
+#include "TTSkeletonReferencePose.h"
+#include "TTBoneIndexRemap.h"
+#include "TTSkeletalMeshRegistry.h"
+#include "TTAnimRecompressionQueue.h"
+#include "TTTextWriter.h"
+#include "TTIntegrationSnapshot.h"
+#include "TTCurveUtils.h"
+
+// Per skeletal mesh state of the bone insertion pipelines (AddRootBone, AddUnweightedBone).
+// The import data is a detached copy that is loaded and saved on the game thread,
+// in between the import data of different skeletal meshes can be modified in parallel.
+struct CSkeletalMeshBoneEdit
+{
+  USkeletalMesh* SkeletalMesh = nullptr;
+  // import data per LOD, only valid if the LOD provides import data ('HasLODImportData')
+  TArray<FSkeletalMeshImportData> LODImportData;
+  TArray<bool> HasLODImportData;
+};
+
+// Curve keys of a source anim montage prepared for all targets with the same frame rate and length ('CopyAnimMontageCurvesToTargets').
+// Without resampling the timing of the targets is irrelevant and all targets share a single instance.
+struct CPreparedCurveKeys
+{
+  FFrameRate FrameRate;
+  double PlayLength = 0.0;
+  // prepared keys per source curve
+  TArray<TArray<FRichCurveKey>> Keys;
+};
+
 // function prototypes
-static FString FVectorToString(const FVector& Vector);
+static bool beginDump(const FString& FilePath, TUniquePtr<FArchive>& OutFileArchive);
+static bool finishDump(CTextWriter& Writer, FArchive* FileArchive, const FString& FilePath);
 static TArray<USkeletalMesh*> getAllSkeletalMeshes(USkeleton* Skeleton);
+static TArray<FSoftObjectPath> getAnimSequencePaths(USkeleton* Skeleton);
+static TArrayView<USkeletalMesh* const> getSkeletalMeshBatch(const TArray<USkeletalMesh*>& SkeletalMeshes, int32 BatchStart);
+static bool prepareSkeletalMeshBoneEdits(USkeleton* Skeleton, TArrayView<USkeletalMesh* const> SkeletalMeshes, FScopedSlowTask& SlowTask, bool CanCancel, TArray<CSkeletalMeshBoneEdit>& OutSkeletalMeshBoneEdits);
+static void saveLODImportData(CSkeletalMeshBoneEdit& SkeletalMeshBoneEdit);
+static void addRootBoneToImportData(FSkeletalMeshImportData& ImportData, const CBoneIndexRemap& BoneIndexRemap);
+static bool hasVirtualBone(USkeleton* Skeleton, const FName& VirtualBoneName);
+static void diffCurveNames(const TArray<FName>& ReferenceCurveNames, const TSet<FName>& ReferenceCurveNameSet, USkeleton* Skeleton, FTTCurveDiff_BP& OutCurveDiff);
+static bool validateIntegrationProfile(USkeleton* Skeleton, const FTTIntegrationProfile& IntegrationProfile);
+// skeleton edits without validation and Modify() calls, used by the single edit functions and the batch apply
+static bool addVirtualBone(USkeleton* Skeleton, const FName& VirtualBoneName, const FName& SourceBoneName, const FName& TargetBoneName);
+static void restoreVirtualBones(USkeleton* Skeleton, const TArray<FVirtualBone>& VirtualBones);
+static void addSocket(USkeleton* Skeleton, const FName& BoneName, const FName& SocketName, const FTransform& RelativeTransform);
+static void setSocket(USkeletalMeshSocket* Socket, const FName& BoneName, const FTransform& RelativeTransform);
+static bool addSkeletonCurve(USkeleton* Skeleton, const FTTSkeletonCurve_BP& SkeletonCurve, bool OverwriteFlags);
+static void setBlendProfile(USkeleton* Skeleton, const FName& BlendProfileName, const FTTBlendProfile_BP& BlendProfile);
+static void addSlotGroup(USkeleton* Skeleton, const FTTMontageSlotGroup& SlotGroup);
+static void copyCurvesToAnimMontage(UAnimMontage* TargetAnimMontage, const TArray<FFloatCurve>& SourceCurves, const TArray<TArray<FRichCurveKey>>& CurveKeys, bool MergeCurves);
 
 // helper variables
 static const FName gs_rootBoneName("root");
+// number of skeletal meshes whose import data is held in memory at once by AddRootBone and AddUnweightedBone
+static const int32 gs_skeletalMeshBatchSize = 16;
 
+#define LOCTEXT_NAMESPACE "TTToolboxBlueprintLibrary"
 
-bool UTTToolboxBlueprintLibrary::DumpVirtualBones(USkeleton* Skeleton)
+
+bool UTTToolboxBlueprintLibrary::DumpVirtualBones(USkeleton* Skeleton, const FString& FilePath)
 {
   // check input arguments
   if (!IsValid(Skeleton))
@@ -67,48 +127,36 @@ bool UTTToolboxBlueprintLibrary::DumpVirtualBones(USkeleton* Skeleton)
     return false;
   }
 
-  // prepare string for virtual bones
-  FString dumpString;
-  dumpString += "(";
+  TUniquePtr<FArchive> fileArchive;
+  if (!beginDump(FilePath, fileArchive))
+  {
+    return false;
+  }
+
+  // prepare text for virtual bones
+  CTextWriter writer(Skeleton->GetVirtualBones().Num() * 160 + 2, fileArchive.Get());
+  writer.Append(TEXT('('));
 
   uint32 count = 0;
   for (auto& virtualBone : Skeleton->GetVirtualBones())
   {
     if (count > 0)
     {
-      dumpString += ",";
+      writer.Append(TEXT(','));
     }
 
-    dumpString += "(";
-
-    dumpString += "VirtualBoneName=\"";
-    dumpString += virtualBone.VirtualBoneName.ToString();
-    dumpString += "\",";
-
-    dumpString += "SourceBoneName=\"";
-    dumpString += virtualBone.SourceBoneName.ToString();
-    dumpString += "\",";
-
-    dumpString += "TargetBoneName=\"";
-    dumpString += virtualBone.TargetBoneName.ToString();
-    dumpString += "\"";
-
-    dumpString += ")";
+    writer.Append(TEXT("(VirtualBoneName=")).AppendQuoted(virtualBone.VirtualBoneName);
+    writer.Append(TEXT(",SourceBoneName=")).AppendQuoted(virtualBone.SourceBoneName);
+    writer.Append(TEXT(",TargetBoneName=")).AppendQuoted(virtualBone.TargetBoneName);
+    writer.Append(TEXT(')'));
 
     count++;
   }
 
-  dumpString += ")";
-
-  // dump virtual bones
-  UE_LOG(LogTemp, Log, TEXT("%s"), *dumpString);
-
-  // copy virtual bones to the clipboard
-#if WITH_EDITOR
-  FPlatformApplicationMisc::ClipboardCopy(*dumpString);
-#endif
+  writer.Append(TEXT(')'));
 
-  return true;
+  // dump virtual bones to the log and the clipboard or the file
+  return finishDump(writer, fileArchive.Get(), FilePath);
 }
 
 bool UTTToolboxBlueprintLibrary::AddVirtualBone(
@@ -183,13 +231,10 @@ bool UTTToolboxBlueprintLibrary::AddVirtualBone(
   }
 
   // try to add virtual bone
-  FName newVirtualBoneName = VirtualBoneName;
-  if (!Skeleton->AddNewVirtualBone(SourceBoneName, TargetBoneName, newVirtualBoneName))
+  if (!addVirtualBone(Skeleton, VirtualBoneName, SourceBoneName, TargetBoneName))
   {
-    UE_LOG(LogTemp, Error, TEXT("Failed to add virtual bone in skeleton \"%s\"."), *(Skeleton->GetFullName()));
     return false;
   }
-  Skeleton->RenameVirtualBone(newVirtualBoneName, VirtualBoneName);
 
   // mark skeleton as dirty
   Skeleton->Modify();
@@ -197,7 +242,7 @@ bool UTTToolboxBlueprintLibrary::AddVirtualBone(
   return true;
 }
 
-bool UTTToolboxBlueprintLibrary::DumpSockets(USkeleton* Skeleton)
+bool UTTToolboxBlueprintLibrary::DumpSockets(USkeleton* Skeleton, const FString& FilePath)
 {
   // check input arguments
   if (!IsValid(Skeleton))
@@ -212,11 +257,17 @@ bool UTTToolboxBlueprintLibrary::DumpSockets(USkeleton* Skeleton)
     return false;
   }
 
-  // prepare string for sockets
-  FString dumpString;
+  TUniquePtr<FArchive> fileArchive;
+  if (!beginDump(FilePath, fileArchive))
+  {
+    return false;
+  }
+
+  // prepare text for sockets
+  CTextWriter writer(Skeleton->Sockets.Num() * 320 + 2, fileArchive.Get());
   if (Skeleton->Sockets.Num() > 1)
   {
-    dumpString += "(";
+    writer.Append(TEXT('('));
   }
 
   uint32 count = 0;
@@ -226,38 +277,21 @@ bool UTTToolboxBlueprintLibrary::DumpSockets(USkeleton* Skeleton)
     {
       if (count > 0)
       {
-        dumpString += ",";
+        writer.Append(TEXT(','));
       }
 
-      dumpString += "(";
-
-      dumpString += "BoneName=\"";
-      dumpString += socket->BoneName.ToString();
-      dumpString += "\",";
-
-      dumpString += "SocketName=\"";
-      dumpString += socket->SocketName.ToString();
-      dumpString += "\",";
-
-      dumpString += "RelativeTransform=(Rotation=(";
+      writer.Append(TEXT("(BoneName=")).AppendQuoted(socket->BoneName);
+      writer.Append(TEXT(",SocketName=")).AppendQuoted(socket->SocketName);
 
       const auto rotation = socket->RelativeRotation.Quaternion();
-      FString rotationString = "X=";
-      rotationString += FString::SanitizeFloat(rotation.X);
-      rotationString += ",Y=";
-      rotationString += FString::SanitizeFloat(rotation.Y);
-      rotationString += ",Z=";
-      rotationString += FString::SanitizeFloat(rotation.Z);
-      rotationString += ",W=";
-      rotationString += FString::SanitizeFloat(rotation.W);
-      dumpString += rotationString;
-
-      dumpString += "),Translation=(";
-      dumpString += FVectorToString(socket->RelativeLocation);
-
-      dumpString += "),Scale3D=(";
-      dumpString += FVectorToString(socket->RelativeScale);
-      dumpString += ")))";
+      writer.Append(TEXT(",RelativeTransform=(Rotation=(X=")).AppendFloat(rotation.X);
+      writer.Append(TEXT(",Y=")).AppendFloat(rotation.Y);
+      writer.Append(TEXT(",Z=")).AppendFloat(rotation.Z);
+      writer.Append(TEXT(",W=")).AppendFloat(rotation.W);
+
+      writer.Append(TEXT("),Translation=(")).AppendVector(socket->RelativeLocation);
+      writer.Append(TEXT("),Scale3D=(")).AppendVector(socket->RelativeScale);
+      writer.Append(TEXT(")))"));
 
       count++;
     }
@@ -265,18 +299,11 @@ bool UTTToolboxBlueprintLibrary::DumpSockets(USkeleton* Skeleton)
 
   if (Skeleton->Sockets.Num() > 1)
   {
-    dumpString += ")";
+    writer.Append(TEXT(')'));
   }
 
-  // dump sockets
-  UE_LOG(LogTemp, Log, TEXT("%s"), *dumpString);
-
-  // copy sockets to the clipboard
-#if WITH_EDITOR
-  FPlatformApplicationMisc::ClipboardCopy(*dumpString);
-#endif
-
-  return true;
+  // dump sockets to the log and the clipboard or the file
+  return finishDump(writer, fileArchive.Get(), FilePath);
 }
 
 bool UTTToolboxBlueprintLibrary::AddSocket(const FName& BoneName, const FName& SocketName, const FTransform& RelativeTransform, USkeleton* Skeleton)
@@ -307,13 +334,7 @@ bool UTTToolboxBlueprintLibrary::AddSocket(const FName& BoneName, const FName& S
   }
 
   // introduce the socket to the skeleton
-  auto socket = NewObject<USkeletalMeshSocket>(Skeleton);
-  socket->BoneName = BoneName;
-  socket->SocketName = SocketName;
-  socket->RelativeLocation = RelativeTransform.GetLocation();
-  socket->RelativeRotation = RelativeTransform.GetRotation().Rotator();
-  socket->RelativeScale = RelativeTransform.GetScale3D();
-  Skeleton->Sockets.Add(socket);
+  addSocket(Skeleton, BoneName, SocketName, RelativeTransform);
 
   // notify the editor that the skeleton was changed
   Skeleton->Modify();
@@ -351,7 +372,7 @@ bool UTTToolboxBlueprintLibrary::HasSocket(const FName& SocketName, USkeleton* S
   return false;
 }
 
-bool UTTToolboxBlueprintLibrary::DumpSkeletonCurveNames(USkeleton* Skeleton)
+bool UTTToolboxBlueprintLibrary::DumpSkeletonCurveNames(USkeleton* Skeleton, const FString& FilePath)
 {
   // check input arguments
   if (!IsValid(Skeleton))
@@ -364,34 +385,33 @@ bool UTTToolboxBlueprintLibrary::DumpSkeletonCurveNames(USkeleton* Skeleton)
   TArray<FName> curveNames;
   Skeleton->GetCurveMetaDataNames(curveNames);
 
-  // prepare dump string
-  FString dumpString = "(";
+  TUniquePtr<FArchive> fileArchive;
+  if (!beginDump(FilePath, fileArchive))
+  {
+    return false;
+  }
+
+  // prepare dump text
+  CTextWriter writer(curveNames.Num() * 40 + 2, fileArchive.Get());
+  writer.Append(TEXT('('));
 
   uint32 count = 0;
-  for (auto curveName : curveNames)
+  for (auto& curveName : curveNames)
   {
     if (count > 0)
     {
-      dumpString += ",";
+      writer.Append(TEXT(','));
     }
 
-    dumpString += "\"";
-    dumpString += curveName.ToString();
-    dumpString += "\"";
+    writer.AppendQuoted(curveName);
 
     count++;
   }
 
-  dumpString += ")";
-
-  // dump curve names
-  UE_LOG(LogTemp, Log, TEXT("%s"), *dumpString);
-
-#if WITH_EDITOR
-  FPlatformApplicationMisc::ClipboardCopy(*dumpString);
-#endif
+  writer.Append(TEXT(')'));
 
-  return true;
+  // dump curve names to the log and the clipboard or the file
+  return finishDump(writer, fileArchive.Get(), FilePath);
 }
 
 bool UTTToolboxBlueprintLibrary::CheckForMissingCurveNames(const TArray<FName>& CurveNamesToCheck, USkeleton* Skeleton)
@@ -403,28 +423,56 @@ bool UTTToolboxBlueprintLibrary::CheckForMissingCurveNames(const TArray<FName>&
     return false;
   }
 
-  // get curve names from target skeleton
-  TArray<FName> skeletonCurveNames;
-  Skeleton->GetCurveMetaDataNames(skeletonCurveNames);
-
   // check if curves are missing in the target skeleton
-  bool hasNoMissingCurveNames = true;
-  for (auto& curveName : CurveNamesToCheck)
+  const FTTCurveDiff_BP curveDiff = DiffSkeletonCurves(CurveNamesToCheck, Skeleton);
+  if (curveDiff.MissingCurves.Num() > 0)
   {
-    if (skeletonCurveNames.Find(curveName) == INDEX_NONE)
+    UE_LOG(LogTemp, Error, TEXT("The following curves are missing in skeleton \"%s\":"), *(Skeleton->GetFullName()));
+    for (auto& curveName : curveDiff.MissingCurves)
     {
-      if (hasNoMissingCurveNames)
-      {
-        UE_LOG(LogTemp, Error, TEXT("The following curves are missing in skeleton \"%s\":"), *(Skeleton->GetFullName()));
-      }
-
       UE_LOG(LogTemp, Error, TEXT("  %s"), *curveName.ToString());
+    }
+  }
+
+  return curveDiff.MissingCurves.Num() == 0;
+}
+
+FTTCurveDiff_BP UTTToolboxBlueprintLibrary::DiffSkeletonCurves(const TArray<FName>& ReferenceCurveNames, USkeleton* Skeleton)
+{
+  FTTCurveDiff_BP curveDiff;
+
+  // check input arguments
+  if (!IsValid(Skeleton))
+  {
+    UE_LOG(LogTemp, Error, TEXT("Called \"DiffSkeletonCurves\" with invalid skeleton."));
+    return curveDiff;
+  }
+
+  const TSet<FName> referenceCurveNames(ReferenceCurveNames);
+  diffCurveNames(ReferenceCurveNames, referenceCurveNames, Skeleton, curveDiff);
+
+  return curveDiff;
+}
+
+TArray<FTTCurveDiff_BP> UTTToolboxBlueprintLibrary::DiffSkeletonsCurves(const TArray<FName>& ReferenceCurveNames, const TArray<USkeleton*>& Skeletons)
+{
+  TArray<FTTCurveDiff_BP> curveDiffs;
+  curveDiffs.Reserve(Skeletons.Num());
 
-      hasNoMissingCurveNames = false;
+  // the reference set is built once for all skeletons
+  const TSet<FName> referenceCurveNames(ReferenceCurveNames);
+  for (auto skeleton : Skeletons)
+  {
+    if (!IsValid(skeleton))
+    {
+      UE_LOG(LogTemp, Error, TEXT("Called \"DiffSkeletonsCurves\" with an invalid skeleton, which will be skipped."));
+      continue;
     }
+
+    diffCurveNames(ReferenceCurveNames, referenceCurveNames, skeleton, curveDiffs.AddDefaulted_GetRef());
   }
 
-  return hasNoMissingCurveNames;
+  return curveDiffs;
 }
 
 bool UTTToolboxBlueprintLibrary::HasSkeletonCurve(USkeleton* Skeleton, const FName& SkeletonCurveName)
@@ -446,7 +494,7 @@ bool UTTToolboxBlueprintLibrary::HasSkeletonCurve(USkeleton* Skeleton, const FNa
     return Skeleton->GetCurveMetaData(SkeletonCurveName) != nullptr;
 }
 
-bool UTTToolboxBlueprintLibrary::DumpSkeletonBlendProfile(USkeleton* Skeleton)
+bool UTTToolboxBlueprintLibrary::DumpSkeletonBlendProfile(USkeleton* Skeleton, const FString& FilePath)
 {
     // check input arguments
     if (!IsValid(Skeleton))
@@ -455,8 +503,21 @@ bool UTTToolboxBlueprintLibrary::DumpSkeletonBlendProfile(USkeleton* Skeleton)
         return false;
     }
 
-    // convert blend profiles to a string
-    FString dumpString = "(";
+    TUniquePtr<FArchive> fileArchive;
+    if (!beginDump(FilePath, fileArchive))
+    {
+        return false;
+    }
+
+    int32 estimatedLength = 2;
+    for (auto& blendProfile : Skeleton->BlendProfiles)
+    {
+        estimatedLength += blendProfile ? 96 + blendProfile->ProfileEntries.Num() * 48 : 0;
+    }
+
+    // convert blend profiles to text
+    CTextWriter writer(estimatedLength, fileArchive.Get());
+    writer.Append(TEXT('('));
     uint32 count = 0;
     FString enumString; // temporary variable for retrieving the enum name
     for (auto& blendProfile : Skeleton->BlendProfiles)
@@ -467,71 +528,45 @@ bool UTTToolboxBlueprintLibrary::DumpSkeletonBlendProfile(USkeleton* Skeleton)
             continue;
         }
 
-        if (count > 0)
-        {
-            dumpString += ",(";
-        }
-        else
-        {
-            dumpString += "(";
-        }
+        writer.Append(count > 0 ? TEXT(",(") : TEXT("("));
 
         // name
-        dumpString += "\"";
-#if ENGINE_MAJOR_VERSION ==	5 &&  ENGINE_MINOR_VERSION < 1
-        dumpString += blendProfile->GetName();
-#elif ENGINE_MAJOR_VERSION ==	5 &&  ENGINE_MINOR_VERSION >= 1
-        dumpString += blendProfile.GetName();
-#endif
-        dumpString += "\", ";
-
-        if (blendProfile)
+        writer.AppendQuoted(blendProfile->GetFName());
+        writer.Append(TEXT(", "));
+
+        writer.Append(TEXT("(BlendProfileMode="));
+        // in 5.1 this was working fine but now it is deprecated and Visual Studio
+        // is using the wrong overload for this enum class 'EBlendProfileMode'.
+        //dumpString += UEnum::GetValueAsString<EBlendProfileMode>(blendProfile->GetMode()).Replace(TEXT("EBlendProfileMode::"), TEXT(""));
+        // But the other overload with only the enum type and the FString is working fine :)
+        UEnum::GetValueAsString<EBlendProfileMode>(blendProfile->GetMode(), enumString);
+        enumString.ReplaceInline(TEXT("EBlendProfileMode::"), TEXT(""));
+        writer.Append(enumString);
+
+        writer.Append(TEXT(",BlendValues=("));
+        uint32 boneCount = 0;
+        for (auto& bone : blendProfile->ProfileEntries)
         {
-            dumpString += "(";
-            dumpString += "BlendProfileMode=";
-            // in 5.1 this was working fine but now it is deprecated and Visual Studio
-            // is using the wrong overload for this enum class 'EBlendProfileMode'.
-            //dumpString += UEnum::GetValueAsString<EBlendProfileMode>(blendProfile->GetMode()).Replace(TEXT("EBlendProfileMode::"), TEXT(""));
-            // But the other overload with only the enum type and the FString is working fine :)
-            UEnum::GetValueAsString<EBlendProfileMode>(blendProfile->GetMode(), enumString);
-            dumpString += enumString.Replace(TEXT("EBlendProfileMode::"), TEXT(""));
-
-            dumpString += ",BlendValues=(";
-            uint32 boneCount = 0;
-            for (auto& bone : blendProfile->ProfileEntries)
+            if (boneCount > 0)
             {
-                if (boneCount > 0)
-                {
-                    dumpString += ",";
-                }
-
-                dumpString += "(\"";
-                dumpString += bone.BoneReference.BoneName.ToString();
-                dumpString += "\", ";
-
-                dumpString += FString::SanitizeFloat(bone.BlendScale);
-                dumpString += ")";
-
-                boneCount++;
+                writer.Append(TEXT(','));
             }
 
-            dumpString += ")";
+            writer.Append(TEXT('(')).AppendQuoted(bone.BoneReference.BoneName);
+            writer.Append(TEXT(", ")).AppendFloat(bone.BlendScale);
+            writer.Append(TEXT(')'));
+
+            boneCount++;
         }
 
-        dumpString += "))";
+        writer.Append(TEXT(")))"));
 
         count++;
     }
-    dumpString += ")";
-
-    // print dump string to the output log
-    UE_LOG(LogTemp, Log, TEXT("%s"), *dumpString);
-
-#if WITH_EDITOR
-    FPlatformApplicationMisc::ClipboardCopy(*dumpString);
-#endif
+    writer.Append(TEXT(')'));
 
-    return true;
+    // print dump text to the output log and the clipboard or the file
+    return finishDump(writer, fileArchive.Get(), FilePath);
 }
 
 bool UTTToolboxBlueprintLibrary::AddSkeletonBlendProfile(USkeleton* Skeleton, const FName& BlendProfileName, const FTTBlendProfile_BP& BlendProfile, bool Overwrite)
@@ -557,29 +592,7 @@ bool UTTToolboxBlueprintLibrary::AddSkeletonBlendProfile(USkeleton* Skeleton, co
         return false;
     }
 
-    // in case a blend profile was not found and a not existing one needs to be overwriten,
-    // a new blend profile is created
-    if (!blendProfile)
-    {
-        blendProfile = Skeleton->CreateNewBlendProfile(BlendProfileName);
-    }
-
-    // fill out blend profile with it's values
-    blendProfile->Mode = BlendProfile.BlendProfileMode;
-
-    blendProfile->ProfileEntries.Empty(BlendProfile.BlendValues.Num());
-    for (auto& blendEntry : BlendProfile.BlendValues)
-    {
-        int32 boneIndex = Skeleton->GetReferenceSkeleton().FindBoneIndex(blendEntry.Key);
-        if (boneIndex == INDEX_NONE)
-        {
-            UE_LOG(LogTemp, Error, TEXT("The bone name \"%s\" did not exist in Skeleton \"%s\" while trying to add the blend profile \"%s\"."),
-                   *blendEntry.Key.ToString(), *Skeleton->GetPathName(), *BlendProfileName.ToString());
-            continue;
-        }
-
-        blendProfile->SetBoneBlendScale(blendEntry.Key, blendEntry.Value, false, true);
-    }
+    setBlendProfile(Skeleton, BlendProfileName, BlendProfile);
 
     return true;
 }
@@ -603,45 +616,53 @@ bool UTTToolboxBlueprintLibrary::AddSkeletonCurve(USkeleton* Skeleton, const FNa
     return Skeleton->AddCurveMetaData(SkeletonCurveName);
 }
 
-bool UTTToolboxBlueprintLibrary::AddSkeletonSlotGroup(USkeleton* Skeleton, const FTTMontageSlotGroup& SlotGroup)
+bool UTTToolboxBlueprintLibrary::AddSkeletonCurves(USkeleton* Skeleton, const TArray<FTTSkeletonCurve_BP>& SkeletonCurves)
 {
     // check input arguments
     if (!IsValid(Skeleton))
     {
-        UE_LOG(LogTemp, Error, TEXT("Called \"DumpGroupsAndSlots\" with invalid \"Skeleton\"."));
+        UE_LOG(LogTemp, Error, TEXT("Called \"AddSkeletonCurves\" with invalid \"Skeleton\"."));
         return false;
     }
 
-    if (SlotGroup.GroupName.IsNone())
+    for (auto& skeletonCurve : SkeletonCurves)
     {
-        UE_LOG(LogTemp, Error, TEXT("Called \"AddSkeletonSlotGroup\" with invalid \"SlotGroup.GroupName\" (\"None\")."));
-        return false;
+        if (skeletonCurve.CurveName.IsNone())
+        {
+            UE_LOG(LogTemp, Error, TEXT("Called \"AddSkeletonCurves\" with invalid \"CurveName\" (\"None\")."));
+            return false;
+        }
     }
 
-    auto slotGroup = Skeleton->FindAnimSlotGroup(SlotGroup.GroupName);
-    if (!slotGroup)
+    if (SkeletonCurves.Num() == 0)
     {
-        (void)Skeleton->AddSlotGroupName(SlotGroup.GroupName); // do not process the return value or raise any warning
-        slotGroup = Skeleton->FindAnimSlotGroup(SlotGroup.GroupName);
+        return true;
     }
 
-    for(int32 ii = 0; ii < SlotGroup.SlotNames.Num(); ii++)
+    int32 numAddedCurves = 0;
     {
-        if (SlotGroup.SlotNames[ii].IsNone())
+        // one undoable modification for all curves, the per curve transaction of AddCurveMetaData is skipped
+        FScopedTransaction transaction(LOCTEXT("AddSkeletonCurves", "Add Skeleton Curves"));
+        Skeleton->Modify();
+
+        for (auto& skeletonCurve : SkeletonCurves)
         {
-            UE_LOG(LogTemp, Error, TEXT("During the call of \"AddSkeletonSlotGroup\" the slot group \"%s\" did contain a invalid slot name (\"None\") at index %i."), *SlotGroup.GroupName.ToString(), ii);
-            continue;
+            if (addSkeletonCurve(Skeleton, skeletonCurve, /*OverwriteFlags*/false))
+            {
+                numAddedCurves++;
+            }
         }
 
-        slotGroup->SlotNames.AddUnique(SlotGroup.SlotNames[ii]);
+        // single change notification for all curves
+        Skeleton->PostEditChange();
     }
 
-    Skeleton->Modify();
+    UE_LOG(LogTemp, Log, TEXT("Added %d of %d curves to the skeleton \"%s\"."), numAddedCurves, SkeletonCurves.Num(), *Skeleton->GetPathName());
 
     return true;
 }
 
-bool UTTToolboxBlueprintLibrary::DumpGroupsAndSlots(USkeleton* Skeleton)
+bool UTTToolboxBlueprintLibrary::AddSkeletonSlotGroup(USkeleton* Skeleton, const FTTMontageSlotGroup& SlotGroup)
 {
     // check input arguments
     if (!IsValid(Skeleton))
@@ -650,158 +671,271 @@ bool UTTToolboxBlueprintLibrary::DumpGroupsAndSlots(USkeleton* Skeleton)
         return false;
     }
 
-    // convert blend profiles to a string
-    // ((GroupName="G",SlotNames=("S1","S2")))
-    FString dumpString = "(";
-    uint32 count = 0;
-    for (auto& group : Skeleton->GetSlotGroups())
+    if (SlotGroup.GroupName.IsNone())
+    {
+        UE_LOG(LogTemp, Error, TEXT("Called \"AddSkeletonSlotGroup\" with invalid \"SlotGroup.GroupName\" (\"None\")."));
+        return false;
+    }
+
+    addSlotGroup(Skeleton, SlotGroup);
+
+    Skeleton->Modify();
+
+    return true;
+}
+
+bool UTTToolboxBlueprintLibrary::ApplyIntegrationProfile(USkeleton* Skeleton, const FTTIntegrationProfile& IntegrationProfile, bool Save)
+{
+    // check input arguments
+    if (!IsValid(Skeleton))
+    {
+        UE_LOG(LogTemp, Error, TEXT("Called \"ApplyIntegrationProfile\" with invalid \"Skeleton\"."));
+        return false;
+    }
+
+    // validate the whole profile up front, so the skeleton is either changed completely or not at all
+    if (!validateIntegrationProfile(Skeleton, IntegrationProfile))
+    {
+        UE_LOG(LogTemp, Error, TEXT("The integration profile is invalid for the skeleton \"%s\", nothing was changed."), *Skeleton->GetPathName());
+        return false;
+    }
+
     {
-        if (count > 0)
+        FScopedTransaction transaction(LOCTEXT("ApplyIntegrationProfile", "Apply Integration Profile"));
+        Skeleton->Modify();
+
+        // virtual bones are changed first, so restoring them on failure leaves the skeleton unchanged
+        const TArray<FVirtualBone> savedVirtualBones = Skeleton->GetVirtualBones();
+
+        if (IntegrationProfile.OverwriteExistingEntries)
         {
-            dumpString += ",(";
+            // virtual bones with the same name but other source or target bones are replaced
+            TArray<FName> replacedVirtualBoneNames;
+            for (auto& virtualBone : IntegrationProfile.VirtualBones)
+            {
+                for (auto& existingVirtualBone : savedVirtualBones)
+                {
+                    if (existingVirtualBone.VirtualBoneName == virtualBone.VirtualBoneName &&
+                        (existingVirtualBone.SourceBoneName != virtualBone.SourceBoneName || existingVirtualBone.TargetBoneName != virtualBone.TargetBoneName))
+                    {
+                        replacedVirtualBoneNames.Add(virtualBone.VirtualBoneName);
+                    }
+                }
+            }
+
+            if (replacedVirtualBoneNames.Num() > 0)
+            {
+                Skeleton->RemoveVirtualBones(replacedVirtualBoneNames);
+            }
         }
-        else
+
+        bool virtualBonesFailed = false;
+        for (auto& virtualBone : IntegrationProfile.VirtualBones)
         {
-            dumpString += "(";
+            if (!hasVirtualBone(Skeleton, virtualBone.VirtualBoneName) &&
+                !addVirtualBone(Skeleton, virtualBone.VirtualBoneName, virtualBone.SourceBoneName, virtualBone.TargetBoneName))
+            {
+                UE_LOG(LogTemp, Error, TEXT("Failed to add the virtual bone \"%s\" to the skeleton \"%s\"."), *virtualBone.VirtualBoneName.ToString(), *Skeleton->GetPathName());
+                virtualBonesFailed = true;
+                break;
+            }
         }
 
-        // name
-        dumpString += "GroupName=\"";
-        dumpString += group.GroupName.ToString();
-        dumpString += "\"";
+        // removing a replaced virtual bone removes the virtual bones built on top of it as well
+        for (int32 ii = 0; ii < savedVirtualBones.Num() && !virtualBonesFailed; ++ii)
+        {
+            const FVirtualBone& virtualBone = savedVirtualBones[ii];
+            if (!hasVirtualBone(Skeleton, virtualBone.VirtualBoneName) &&
+                !addVirtualBone(Skeleton, virtualBone.VirtualBoneName, virtualBone.SourceBoneName, virtualBone.TargetBoneName))
+            {
+                virtualBonesFailed = true;
+            }
+        }
 
-        uint32 slotCount = 0;
-        if (group.SlotNames.Num() > 0)
+        if (virtualBonesFailed)
         {
-            dumpString += ",SlotNames=(";
+            restoreVirtualBones(Skeleton, savedVirtualBones);
+            transaction.Cancel();
+
+            UE_LOG(LogTemp, Error, TEXT("Failed to apply the virtual bones of the integration profile to the skeleton \"%s\", nothing was changed."), *Skeleton->GetPathName());
+            return false;
         }
-        for (auto& slot : group.SlotNames)
+
+        for (auto& socket : IntegrationProfile.Sockets)
         {
-            if (slotCount > 0)
+            if (USkeletalMeshSocket* existingSocket = Skeleton->FindSocket(socket.SocketName))
             {
-                dumpString += ",";
+                if (IntegrationProfile.OverwriteExistingEntries)
+                {
+                    existingSocket->Modify();
+                    setSocket(existingSocket, socket.BoneName, socket.RelativeTransform);
+                }
             }
+            else
+            {
+                addSocket(Skeleton, socket.BoneName, socket.SocketName, socket.RelativeTransform);
+            }
+        }
 
-            dumpString += "\"";
-            dumpString += slot.ToString();
-            dumpString += "\"";
-
-            slotCount++;
+        for (auto& skeletonCurve : IntegrationProfile.SkeletonCurves)
+        {
+            addSkeletonCurve(Skeleton, skeletonCurve, IntegrationProfile.OverwriteExistingEntries);
         }
 
-        if (group.SlotNames.Num() > 0)
+        for (auto& blendProfile : IntegrationProfile.BlendProfiles)
         {
-            dumpString += ")";
+            setBlendProfile(Skeleton, blendProfile.Key, blendProfile.Value);
         }
 
-        dumpString += ")";
+        for (auto& slotGroup : IntegrationProfile.SlotGroups)
+        {
+            addSlotGroup(Skeleton, slotGroup);
+        }
 
-        count++;
+        // single change notification for all edits
+        Skeleton->PostEditChange();
     }
-    dumpString += ")";
 
-    // print dump string to the output log
-    UE_LOG(LogTemp, Log, TEXT("%s"), *dumpString);
-
-#if WITH_EDITOR
-    FPlatformApplicationMisc::ClipboardCopy(*dumpString);
-#endif
+    if (Save && !UEditorLoadingAndSavingUtils::SavePackages({ Skeleton->GetPackage() }, /*bOnlyDirty*/true))
+    {
+        UE_LOG(LogTemp, Error, TEXT("Failed to save the skeleton \"%s\"."), *Skeleton->GetPathName());
+        return false;
+    }
 
     return true;
 }
 
-//! @todo @ffs check if the engine class could be used here
-struct CSkeletonReferencePose
+bool UTTToolboxBlueprintLibrary::ExportIntegrationSnapshot(USkeleton* Skeleton, UIKRigDefinition* IKRigDefinition, const FString& FilePath)
 {
-  CSkeletonReferencePose(const FReferenceSkeleton& ReferenceSkeleton)
-    : m_referenceSkeleton(ReferenceSkeleton)
-  {
-    m_localSpacePoses.SetNumZeroed(m_referenceSkeleton.GetNum());
-    for (int32 ii = 0; ii < m_referenceSkeleton.GetNum(); ++ii)
+    // check input arguments
+    if (!IsValid(Skeleton))
     {
-      m_localSpacePoses[ii] = m_referenceSkeleton.GetRefBonePose()[ii];
+        UE_LOG(LogTemp, Error, TEXT("Called \"ExportIntegrationSnapshot\" with invalid \"Skeleton\"."));
+        return false;
     }
 
-    calculateWorldSpaceTransforms();
-  }
+    if (FilePath.IsEmpty())
+    {
+        UE_LOG(LogTemp, Error, TEXT("Called \"ExportIntegrationSnapshot\" with empty \"FilePath\"."));
+        return false;
+    }
 
-  enum class EBonePoseSpaces : uint8
-  {
-    // Local (bone) space 
-    Local,
-    // World (component) space
-    World
-  };
+    FTTIntegrationSnapshot snapshot;
+    CIntegrationSnapshotFile::Capture(Skeleton, IKRigDefinition, snapshot);
+    return CIntegrationSnapshotFile::Save(snapshot, FilePath);
+}
 
-  void SetBonePose(const FName& BoneName, const FTransform& Transform, EBonePoseSpaces Space = EBonePoseSpaces::Local)
-  {
-    int32 boneIndex = m_referenceSkeleton.FindBoneIndex(BoneName);
-    if (boneIndex == INDEX_NONE)
+bool UTTToolboxBlueprintLibrary::ImportIntegrationSnapshot(USkeleton* Skeleton, UIKRigDefinition* IKRigDefinition, const FString& FilePath, bool Save)
+{
+    // check input arguments
+    if (!IsValid(Skeleton))
     {
-      UE_LOG(LogTemp, Error, TEXT("The bone name \"%s\" is not present to calculate the local and world transforms. Please create an issue here https://github.com/tuatec/TTToolbox/issues."), *BoneName.ToString());
-      return;
+        UE_LOG(LogTemp, Error, TEXT("Called \"ImportIntegrationSnapshot\" with invalid \"Skeleton\"."));
+        return false;
     }
 
-    if (Space == EBonePoseSpaces::Local)
+    FTTIntegrationSnapshot snapshot;
+    if (!CIntegrationSnapshotFile::Load(FilePath, snapshot))
     {
-      m_localSpacePoses[boneIndex] = Transform;
+        return false;
     }
-    else
+
+    // the skeleton reproduces the snapshot, all skeleton edits are applied in one transaction
+    snapshot.Profile.OverwriteExistingEntries = true;
+    snapshot.Profile.OverwriteBlendProfiles = true;
+    if (!ApplyIntegrationProfile(Skeleton, snapshot.Profile, Save))
     {
-      const int32 parentIndex = m_referenceSkeleton.GetParentIndex(boneIndex);
-      const FTransform ParentTransformWS = parentIndex != INDEX_NONE ? m_worldSpacePoses[parentIndex] : FTransform::Identity;
-      m_localSpacePoses[boneIndex] = Transform.GetRelativeTransform(ParentTransformWS);
+        return false;
     }
 
-    calculateWorldSpaceTransforms();
-  }
-
-  const FTransform& GetRefBonePose(const FName& BoneName, EBonePoseSpaces Space = EBonePoseSpaces::Local)
-  {
-    int32 boneIndex = m_referenceSkeleton.FindBoneIndex(BoneName);
-    if (boneIndex == INDEX_NONE)
+    if (IsValid(IKRigDefinition) && snapshot.IKBoneChains.Num() > 0)
     {
-      return FTransform::Identity;
+        if (!AddIKBoneChains(IKRigDefinition, snapshot.IKBoneChains))
+        {
+            return false;
+        }
+
+        if (Save && !UEditorLoadingAndSavingUtils::SavePackages({ IKRigDefinition->GetPackage() }, /*bOnlyDirty*/true))
+        {
+            UE_LOG(LogTemp, Error, TEXT("Failed to save the ik rig \"%s\"."), *IKRigDefinition->GetPathName());
+            return false;
+        }
     }
 
-    return Space == EBonePoseSpaces::Local ? m_localSpacePoses[boneIndex] : m_worldSpacePoses[boneIndex];
-  }
+    return true;
+}
 
-private:
-  void calculateWorldSpaceTransforms()
-  {
-    TArray<bool> processed;
-    processed.SetNumZeroed(m_localSpacePoses.Num());
-    m_worldSpacePoses.SetNum(m_localSpacePoses.Num());
-    for (int32 ii = 0; ii < m_referenceSkeleton.GetNum(); ++ii)
+bool UTTToolboxBlueprintLibrary::DumpGroupsAndSlots(USkeleton* Skeleton, const FString& FilePath)
+{
+    // check input arguments
+    if (!IsValid(Skeleton))
     {
-      const int32 ParentIndex = m_referenceSkeleton.GetParentIndex(ii);
-      if (ParentIndex != INDEX_NONE)
-      {
-        //ensure(Processed[ii]);
-        m_worldSpacePoses[ii] = m_localSpacePoses[ii] * m_worldSpacePoses[ParentIndex];
-      }
-      else
-      {
-        m_worldSpacePoses[ii] = m_localSpacePoses[ii];
-      }
+        UE_LOG(LogTemp, Error, TEXT("Called \"DumpGroupsAndSlots\" with invalid \"Skeleton\"."));
+        return false;
+    }
 
-      processed[ii] = true;
+    TUniquePtr<FArchive> fileArchive;
+    if (!beginDump(FilePath, fileArchive))
+    {
+        return false;
     }
-  }
 
-  const FReferenceSkeleton& m_referenceSkeleton;
-  TArray<FTransform> m_localSpacePoses;
+    int32 estimatedLength = 2;
+    for (auto& group : Skeleton->GetSlotGroups())
+    {
+        estimatedLength += 64 + group.SlotNames.Num() * 40;
+    }
 
-  TArray<FTransform> m_worldSpacePoses;
-};
+    // convert slot groups to text
+    // ((GroupName="G",SlotNames=("S1","S2")))
+    CTextWriter writer(estimatedLength, fileArchive.Get());
+    writer.Append(TEXT('('));
+    uint32 count = 0;
+    for (auto& group : Skeleton->GetSlotGroups())
+    {
+        writer.Append(count > 0 ? TEXT(",(") : TEXT("("));
 
-bool UTTToolboxBlueprintLibrary::AddUnweightedBone(const TArray<FTTNewBone_BP>& NewBones, USkeleton* Skeleton)
-{
-  if(!IsValid(Skeleton))
-  {
-    UE_LOG(LogTemp, Error, TEXT("Invalid input. AddUnweightedBone was called with an invalid skeleton asset. Adding unweighted bones will be aborted."));
-    return false;
+        // name
+        writer.Append(TEXT("GroupName=")).AppendQuoted(group.GroupName);
+
+        uint32 slotCount = 0;
+        if (group.SlotNames.Num() > 0)
+        {
+            writer.Append(TEXT(",SlotNames=("));
+        }
+        for (auto& slot : group.SlotNames)
+        {
+            if (slotCount > 0)
+            {
+                writer.Append(TEXT(','));
+            }
+
+            writer.AppendQuoted(slot);
+
+            slotCount++;
+        }
+
+        if (group.SlotNames.Num() > 0)
+        {
+            writer.Append(TEXT(')'));
+        }
+
+        writer.Append(TEXT(')'));
+
+        count++;
+    }
+    writer.Append(TEXT(')'));
+
+    // print dump text to the output log and the clipboard or the file
+    return finishDump(writer, fileArchive.Get(), FilePath);
+}
+
+bool UTTToolboxBlueprintLibrary::AddUnweightedBone(const TArray<FTTNewBone_BP>& NewBones, USkeleton* Skeleton)
+{
+  if(!IsValid(Skeleton))
+  {
+    UE_LOG(LogTemp, Error, TEXT("Invalid input. AddUnweightedBone was called with an invalid skeleton asset. Adding unweighted bones will be aborted."));
+    return false;
   }
 
   if (NewBones.Num() <= 0)
@@ -864,6 +998,20 @@ bool UTTToolboxBlueprintLibrary::AddUnweightedBone(const TArray<FTTNewBone_BP>&
     return false;
   }
 
+  // Loading the import data is the only expensive step that does not modify any asset,
+  // that's why it can only be cancelled while loading the first batch. Afterwards all meshes need to be adapted to stay consistent.
+  // The meshes are processed in batches to bound the amount of import data held in memory.
+  const int32 numBatches = FMath::DivideAndRoundUp(skeletalMeshes.Num(), gs_skeletalMeshBatchSize);
+  FScopedSlowTask slowTask(2.f * skeletalMeshes.Num() + numBatches, LOCTEXT("AddUnweightedBones", "Adding unweighted bones..."));
+  slowTask.MakeDialog(/*bShowCancelButton*/true);
+
+  TArray<CSkeletalMeshBoneEdit> skeletalMeshBoneEdits;
+  if (!prepareSkeletalMeshBoneEdits(Skeleton, getSkeletalMeshBatch(skeletalMeshes, 0), slowTask, /*CanCancel*/true, skeletalMeshBoneEdits))
+  {
+    UE_LOG(LogTemp, Warning, TEXT("Adding unweighted bones to \"%s\" was cancelled, no assets were modified."), *Skeleton->GetPathName());
+    return false;
+  }
+
   // Sadly, the implementation does have some issues with wrong bone indices, 
   // see https://github.com/tuatec/TTToolbox/issues/5#issuecomment-1184052765 for the details.
   // That's why all virtual bones get removed (same state if a skeletal mesh is imported through an fbx file)
@@ -891,130 +1039,170 @@ bool UTTToolboxBlueprintLibrary::AddUnweightedBone(const TArray<FTTNewBone_BP>&
   //  skeletalMesh->FlushRenderState();
   //}
 
-  for (auto skeletalMesh : skeletalMeshes)
+  // final bone indices of the new bones per skeletal mesh
+  struct CAddedBone
+  {
+    FName Name;
+    int32 BoneIndex = INDEX_NONE;
+    int32 ParentBoneIndex = INDEX_NONE;
+  };
+  TArray<TArray<CAddedBone>> addedBonesPerMesh;
+
+  for (int32 batchStart = 0; batchStart < skeletalMeshes.Num(); batchStart += gs_skeletalMeshBatchSize)
   {
-    if (Skeleton == skeletalMesh->GetSkeleton())
+    if (batchStart > 0)
     {
+      prepareSkeletalMeshBoneEdits(Skeleton, getSkeletalMeshBatch(skeletalMeshes, batchStart), slowTask, /*CanCancel*/false, skeletalMeshBoneEdits);
+    }
+
+    addedBonesPerMesh.Reset();
+    addedBonesPerMesh.SetNum(skeletalMeshBoneEdits.Num());
+
+    for (int32 meshIndex = 0; meshIndex < skeletalMeshBoneEdits.Num(); ++meshIndex)
+    {
+      USkeletalMesh* skeletalMesh = skeletalMeshBoneEdits[meshIndex].SkeletalMesh;
+
       //! @todo @ffs release renderer ressources
       //skeletalMesh->FlushRenderState();
       //skeletalMesh->ReleaseResources();
       //skeletalMesh->ReleaseResourcesFence.Wait();
-  
-      for (auto& newBone : NewBones)
-      {
-        { // add bones to the reference skeleton of the skeletal mesh
-          int32 parentBoneIndex = INDEX_NONE;
-          FMeshBoneInfo meshParentBoneInfo;
-          for (int32 ii = 0; ii < skeletalMesh->GetRefSkeleton().GetRawBoneNum(); ii++)
-          {
-            const FMeshBoneInfo meshBoneInfo = skeletalMesh->GetRefSkeleton().GetRawRefBoneInfo()[ii];
-            if (meshBoneInfo.Name == newBone.ParentBone)
-            {
-              meshParentBoneInfo = meshBoneInfo;
-              parentBoneIndex = ii;
-              break;
-            }
-          }
-  
+
+      { // add all bones to the reference skeleton of the skeletal mesh with a single rebuild of the reference skeleton
+        FReferenceSkeletonModifier referenceSkeletonModifier(skeletalMesh->GetRefSkeleton(), Skeleton);
+        for (auto& newBone : NewBones)
+        {
+          // the raw bone indices are updated while adding bones, so new bones can be parents of following new bones
+          const int32 parentBoneIndex = skeletalMesh->GetRefSkeleton().FindRawBoneIndex(newBone.ParentBone);
           if (parentBoneIndex == INDEX_NONE)
           {
             UE_LOG(LogTemp, Error, TEXT("parent bone \"%s\" of the new bone \"%s\" not found in reference skeleton skipping..."), *newBone.ParentBone.ToString(), *newBone.NewBoneName.ToString());
             continue;
           }
-  
-          FReferenceSkeletonModifier referenceSkeletonModifier(skeletalMesh->GetRefSkeleton(), Skeleton);
+
           const FMeshBoneInfo newFMeshBoneInfo(newBone.NewBoneName, newBone.NewBoneName.ToString(), parentBoneIndex);
           referenceSkeletonModifier.Add(newFMeshBoneInfo, FTransform::Identity);
         }
-  
-        int32 LODIdx = 0;
-        for (FSkeletalMeshLODModel& skeletalMeshLODModel : skeletalMesh->GetImportedModel()->LODModels)
+      }
+
+      // resolve the final bone indices once for all LODs
+      TArray<CAddedBone>& addedBones = addedBonesPerMesh[meshIndex];
+      addedBones.Reserve(NewBones.Num());
+      for (auto& newBone : NewBones)
+      {
+        const int32 parentBoneIndex = skeletalMesh->GetRefSkeleton().FindBoneIndex(newBone.ParentBone);
+        if (parentBoneIndex == INDEX_NONE)
         {
-          int32 parentBoneIndex = skeletalMesh->GetRefSkeleton().FindBoneIndex(newBone.ParentBone);
-          if (parentBoneIndex == INDEX_NONE)
-          {
-            UE_LOG(LogTemp, Warning, TEXT("During LOD adaption the parent bone \"%s\" was not present in the skeletal mesh \"%s\""),
-              *newBone.ParentBone.ToString(), *skeletalMesh->GetPathName());
-            continue;
-          }
+          UE_LOG(LogTemp, Warning, TEXT("During LOD adaption the parent bone \"%s\" was not present in the skeletal mesh \"%s\""),
+            *newBone.ParentBone.ToString(), *skeletalMesh->GetPathName());
+          continue;
+        }
 
-          int32 newBoneIndex = skeletalMesh->GetRefSkeleton().FindBoneIndex(newBone.NewBoneName);
-          if (newBoneIndex == INDEX_NONE)
-          {
-            UE_LOG(LogTemp, Warning, TEXT("During LOD adaption the new bone \"%s\" was not present in the skeletal mesh \"%s\""),
-              *newBone.NewBoneName.ToString(), *skeletalMesh->GetPathName());
-            continue;
-          }
-        
-          skeletalMeshLODModel.RequiredBones.Add(newBoneIndex);
-#if ENGINE_MAJOR_VERSION ==	5 &&  ENGINE_MINOR_VERSION <= 3
-          if (skeletalMesh->IsLODImportedDataBuildAvailable(LODIdx) && !skeletalMesh->IsLODImportedDataEmpty(LODIdx))
-#elif ENGINE_MAJOR_VERSION ==	5 &&  ENGINE_MINOR_VERSION > 3
-          if (skeletalMesh->HasMeshDescription(LODIdx))
-#endif
-          {
-            FSkeletalMeshImportData skeletalMeshImportData;
-#if ENGINE_MAJOR_VERSION ==	5 &&  ENGINE_MINOR_VERSION <= 3
-            skeletalMesh->LoadLODImportedData(LODIdx, skeletalMeshImportData);
-#elif ENGINE_MAJOR_VERSION ==	5 &&  ENGINE_MINOR_VERSION > 3
-            if (const FMeshDescription* MeshDescription = skeletalMesh->GetMeshDescription(LODIdx))
-            {
-              skeletalMeshImportData = FSkeletalMeshImportData::CreateFromMeshDescription(*MeshDescription);
-            }
-#endif
-        
-            skeletalMeshImportData.RefBonesBinary[parentBoneIndex].NumChildren++;
-            const SkeletalMeshImportData::FJointPos NewRootPos = { FTransform3f::Identity, 1.f, 100.f, 100.f, 100.f };
-            const SkeletalMeshImportData::FBone bone = { newBone.NewBoneName.ToString(), 0, /*NumChildren*/0, parentBoneIndex, NewRootPos };
-            skeletalMeshImportData.RefBonesBinary.Add(bone);
+        const int32 newBoneIndex = skeletalMesh->GetRefSkeleton().FindBoneIndex(newBone.NewBoneName);
+        if (newBoneIndex == INDEX_NONE)
+        {
+          UE_LOG(LogTemp, Warning, TEXT("During LOD adaption the new bone \"%s\" was not present in the skeletal mesh \"%s\""),
+            *newBone.NewBoneName.ToString(), *skeletalMesh->GetPathName());
+          continue;
+        }
 
-#if ENGINE_MAJOR_VERSION ==	5 &&  ENGINE_MINOR_VERSION <= 3
-            skeletalMesh->SaveLODImportedData(LODIdx, skeletalMeshImportData);
-#elif ENGINE_MAJOR_VERSION ==	5 &&  ENGINE_MINOR_VERSION > 3
-            skeletalMesh->CommitMeshDescription(LODIdx);
-#endif
-          }
-          else
+        addedBones.Add({ newBone.NewBoneName, newBoneIndex, parentBoneIndex });
+      }
+    }
+
+    // Add all new bones to the import data of each LOD. The import data are detached copies owned by the bone edits,
+    // so the skeletal meshes can be processed in parallel without touching any UObject.
+    slowTask.EnterProgressFrame(1.f, LOCTEXT("AddUnweightedBonesToLODs", "Adding bones to the LOD import data..."));
+    ParallelFor(skeletalMeshBoneEdits.Num(), [&skeletalMeshBoneEdits, &addedBonesPerMesh](int32 meshIndex)
+    {
+      CSkeletalMeshBoneEdit& skeletalMeshBoneEdit = skeletalMeshBoneEdits[meshIndex];
+      const TArray<CAddedBone>& addedBones = addedBonesPerMesh[meshIndex];
+
+      for (int32 LODIdx = 0; LODIdx < skeletalMeshBoneEdit.LODImportData.Num(); ++LODIdx)
+      {
+        if (!skeletalMeshBoneEdit.HasLODImportData[LODIdx])
+        {
+          continue;
+        }
+
+        FSkeletalMeshImportData& skeletalMeshImportData = skeletalMeshBoneEdit.LODImportData[LODIdx];
+        skeletalMeshImportData.RefBonesBinary.Reserve(skeletalMeshImportData.RefBonesBinary.Num() + addedBones.Num());
+        for (auto& addedBone : addedBones)
+        {
+          skeletalMeshImportData.RefBonesBinary[addedBone.ParentBoneIndex].NumChildren++;
+          const SkeletalMeshImportData::FJointPos NewRootPos = { FTransform3f::Identity, 1.f, 100.f, 100.f, 100.f };
+          const SkeletalMeshImportData::FBone bone = { addedBone.Name.ToString(), 0, /*NumChildren*/0, addedBone.ParentBoneIndex, NewRootPos };
+          skeletalMeshImportData.RefBonesBinary.Add(bone);
+        }
+      }
+    });
+
+    // commit the changes of each skeletal mesh, the LOD models and the engine APIs used here need to be accessed on the game thread
+    for (int32 meshIndex = 0; meshIndex < skeletalMeshBoneEdits.Num(); ++meshIndex)
+    {
+      CSkeletalMeshBoneEdit& skeletalMeshBoneEdit = skeletalMeshBoneEdits[meshIndex];
+      USkeletalMesh* skeletalMesh = skeletalMeshBoneEdit.SkeletalMesh;
+      slowTask.EnterProgressFrame(1.f, FText::Format(LOCTEXT("CommitSkeletalMesh", "Updating {0}..."), FText::FromString(skeletalMesh->GetName())));
+
+      int32 LODIdx = 0;
+      for (FSkeletalMeshLODModel& skeletalMeshLODModel : skeletalMesh->GetImportedModel()->LODModels)
+      {
+        for (auto& addedBone : addedBonesPerMesh[meshIndex])
+        {
+          skeletalMeshLODModel.RequiredBones.Add(addedBone.BoneIndex);
+        }
+
+        // the section bone maps are rebuilt from the import data if available
+        if (!skeletalMeshBoneEdit.HasLODImportData[LODIdx])
+        {
+          for (auto& skelMeshSection : skeletalMeshLODModel.Sections)
           {
-            for (auto& skelMeshSection : skeletalMeshLODModel.Sections)
+            for (auto& addedBone : addedBonesPerMesh[meshIndex])
             {
-              skelMeshSection.BoneMap.Add(newBoneIndex);
+              skelMeshSection.BoneMap.Add(addedBone.BoneIndex);
             }
           }
         }
+
+        ++LODIdx;
       }
-  
+
+      saveLODImportData(skeletalMeshBoneEdit);
+
       //! @todo @ffs release renderer ressources
       //skeletalMesh->PostEditChange();
       //skeletalMesh->InitResources();
-  
+
       // the mesh got new bones and now it is necessary to merge those bones into the USkeleton asset as well
       if (!(Skeleton->MergeAllBonesToBoneTree(skeletalMesh)))
       {
         UE_LOG(LogTemp, Error, TEXT("The final step of merging all bones for the skeletal mesh \"%s\"into the bone failed. Please create an issue here https://github.com/tuatec/TTToolbox/issues."), *(skeletalMesh->GetPathName()));
       }
-  
-      for (auto& newBone : NewBones)
+
       {
-        // constraint bone within the reference pose
-        int32 constrainBoneIndex = skeletalMesh->GetRefSkeleton().FindBoneIndex(newBone.ConstraintBone);
-        if (constrainBoneIndex == INDEX_NONE)
-        {
-          UE_LOG(LogTemp, Warning, TEXT("constraint bone \"%s\" was not found in the reference skeleton of skeleton asset \"%s\" applying identity transform."), *newBone.ConstraintBone.ToString(), *(Skeleton->GetPathName()));
-        }
-        else if (constrainBoneIndex >= skeletalMesh->GetRefSkeleton().GetRefBonePose().Num())
-        {
-          UE_LOG(LogTemp, Warning, TEXT("constraint bone \"%s\" index is not valid."), *newBone.ConstraintBone.ToString());
-        }
-        else
+        // one reference pose per skeletal mesh, constraining a bone only updates the world space transforms of the changed bones lazily
+        CSkeletonReferencePose skeletonReferencePose(skeletalMesh->GetRefSkeleton());
+        FReferenceSkeletonModifier referenceSkeletonModifier(skeletalMesh->GetRefSkeleton(), Skeleton);
+
+        for (auto& newBone : NewBones)
         {
-          CSkeletonReferencePose skeletonReferencePose(skeletalMesh->GetRefSkeleton());
-          const FTransform worldTransform = skeletonReferencePose.GetRefBonePose(newBone.ConstraintBone, CSkeletonReferencePose::EBonePoseSpaces::World);
-          skeletonReferencePose.SetBonePose(newBone.NewBoneName, worldTransform, CSkeletonReferencePose::EBonePoseSpaces::World);
-          const FTransform newBoneTransform = skeletonReferencePose.GetRefBonePose(newBone.NewBoneName);
-  
-          FReferenceSkeletonModifier referenceSkeletonModifier(skeletalMesh->GetRefSkeleton(), Skeleton);
-          referenceSkeletonModifier.UpdateRefPoseTransform(skeletalMesh->GetRefSkeleton().FindBoneIndex(newBone.NewBoneName), newBoneTransform);
+          // constraint bone within the reference pose
+          int32 constrainBoneIndex = skeletalMesh->GetRefSkeleton().FindBoneIndex(newBone.ConstraintBone);
+          if (constrainBoneIndex == INDEX_NONE)
+          {
+            UE_LOG(LogTemp, Warning, TEXT("constraint bone \"%s\" was not found in the reference skeleton of skeleton asset \"%s\" applying identity transform."), *newBone.ConstraintBone.ToString(), *(Skeleton->GetPathName()));
+          }
+          else if (constrainBoneIndex >= skeletalMesh->GetRefSkeleton().GetRefBonePose().Num())
+          {
+            UE_LOG(LogTemp, Warning, TEXT("constraint bone \"%s\" index is not valid."), *newBone.ConstraintBone.ToString());
+          }
+          else
+          {
+            const FTransform worldTransform = skeletonReferencePose.GetRefBonePose(newBone.ConstraintBone, CSkeletonReferencePose::EBonePoseSpaces::World);
+            skeletonReferencePose.SetBonePose(newBone.NewBoneName, worldTransform, CSkeletonReferencePose::EBonePoseSpaces::World);
+            const FTransform newBoneTransform = skeletonReferencePose.GetRefBonePose(newBone.NewBoneName);
+
+            referenceSkeletonModifier.UpdateRefPoseTransform(skeletalMesh->GetRefSkeleton().FindBoneIndex(newBone.NewBoneName), newBoneTransform);
+          }
         }
       }
 
@@ -1033,7 +1221,7 @@ bool UTTToolboxBlueprintLibrary::AddUnweightedBone(const TArray<FTTNewBone_BP>&
         UE_LOG(LogTemp, Error, TEXT("failed to add dirty virtual bone hack to force the rebuild of the bone mapping table of skeleton <todo-name>"));
       }
       Skeleton->RemoveVirtualBones({ virtualBoneName });
-      
+
       skeletalMesh->PostEditChange();
       //skeletalMesh->InitResources();
       skeletalMesh->Modify();
@@ -1062,28 +1250,44 @@ bool UTTToolboxBlueprintLibrary::AddUnweightedBone(const TArray<FTTNewBone_BP>&
 }
 
 void UTTToolboxBlueprintLibrary::RequestAnimationRecompress(USkeleton* Skeleton)
+{
+  if (RequestAnimationRecompressAsync(Skeleton, FTTOnAnimRecompressionProgress(), FTTOnAnimRecompressionCompleted()))
+  {
+    // synchronous callers expect all compressions to be finished on return
+    CAnimRecompressionQueue::Get().Flush();
+  }
+}
+
+bool UTTToolboxBlueprintLibrary::RequestAnimationRecompressAsync(USkeleton* Skeleton, const FTTOnAnimRecompressionProgress& OnProgress, const FTTOnAnimRecompressionCompleted& OnCompleted)
 {
   // check input arguments
   if (!IsValid(Skeleton))
   {
     UE_LOG(LogTemp, Error, TEXT("Called \"RequestAnimationRecompress\" with invalid skeleton."));
-    return;
+    return false;
   }
 
-  TArray<FAssetData> assets;
-  IAssetRegistry& assetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
-  assetRegistry.GetAssetsByClass(UAnimSequence::StaticClass()->GetClassPathName(), assets);
-
-  for (auto& asset : assets)
+  TArray<FSoftObjectPath> animSequencePaths = getAnimSequencePaths(Skeleton);
+  if (animSequencePaths.IsEmpty())
   {
-    if (auto animSequence = Cast<UAnimSequence>(asset.GetAsset()))
-    {
-      if (animSequence->GetSkeleton()->GetFName() == Skeleton->GetFName())
-      {
-        animSequence->BeginCacheDerivedDataForCurrentPlatform();
-      }
-    }
+    UE_LOG(LogTemp, Warning, TEXT("No animation sequences found that are connected to the skeleton \"%s\"."), *Skeleton->GetPathName());
+    OnCompleted.ExecuteIfBound(0);
+    return false;
   }
+
+  UE_LOG(LogTemp, Display, TEXT("Requesting recompression of %d animation sequences of the skeleton \"%s\"."), animSequencePaths.Num(), *Skeleton->GetPathName());
+
+  CAnimRecompressionQueue::Get().Enqueue(MoveTemp(animSequencePaths),
+    CAnimRecompressionQueue::FOnProgress::CreateLambda([OnProgress](int32 NumFinished, int32 NumAnimSequences)
+    {
+      OnProgress.ExecuteIfBound(NumFinished, NumAnimSequences);
+    }),
+    CAnimRecompressionQueue::FOnCompleted::CreateLambda([OnCompleted](int32 NumCompressed)
+    {
+      OnCompleted.ExecuteIfBound(NumCompressed);
+    }));
+
+  return true;
 }
 
 void UTTToolboxBlueprintLibrary::RequestAnimSequencesRecompression(TArray<UAnimSequence*> AnimSequences)
@@ -1152,6 +1356,20 @@ bool UTTToolboxBlueprintLibrary::AddRootBone(USkeleton* Skeleton)
     return false;
   }
 
+  // Loading the import data is the only expensive step that does not modify any asset,
+  // that's why it can only be cancelled while loading the first batch. Afterwards all meshes need to be adapted to stay consistent.
+  // The meshes are processed in batches to bound the amount of import data held in memory.
+  const int32 numBatches = FMath::DivideAndRoundUp(skeletalMeshes.Num(), gs_skeletalMeshBatchSize);
+  FScopedSlowTask slowTask(2.f * skeletalMeshes.Num() + numBatches, LOCTEXT("AddRootBone", "Adding root bone..."));
+  slowTask.MakeDialog(/*bShowCancelButton*/true);
+
+  TArray<CSkeletalMeshBoneEdit> skeletalMeshBoneEdits;
+  if (!prepareSkeletalMeshBoneEdits(Skeleton, getSkeletalMeshBatch(skeletalMeshes, 0), slowTask, /*CanCancel*/true, skeletalMeshBoneEdits))
+  {
+    UE_LOG(LogTemp, Warning, TEXT("Adding the root bone to \"%s\" was cancelled, no assets were modified."), *Skeleton->GetPathName());
+    return false;
+  }
+
   // Sadly, the implementation does have some issues with wrong bone indices, 
   // see https://github.com/tuatec/TTToolbox/issues/5#issuecomment-1184052765 for the details.
   // That's why all virtual bones get removed (same state if a skeletal mesh is imported through an fbx file)
@@ -1170,11 +1388,25 @@ bool UTTToolboxBlueprintLibrary::AddRootBone(USkeleton* Skeleton)
     }
   }
 
+  // The reference skeleton of the skeleton already contains the root bone after the first mesh has been committed,
+  // so all meshes get their reference skeleton out of the state before the change.
+  const FReferenceSkeleton skeletonReferenceSkeleton = Skeleton->GetReferenceSkeleton();
+
+  // all other bones are shifted by one
+  const CBoneIndexRemap boneIndexRemap = CBoneIndexRemap::CreateInsertion(skeletonReferenceSkeleton.GetRawBoneNum(), 0);
+
   uint32 modifiedSkeletalMeshes = 0;
-  for (auto skeletalMesh : skeletalMeshes)
+  for (int32 batchStart = 0; batchStart < skeletalMeshes.Num(); batchStart += gs_skeletalMeshBatchSize)
   {
-    if (Skeleton == skeletalMesh->GetSkeleton())
+    if (batchStart > 0)
     {
+      prepareSkeletalMeshBoneEdits(Skeleton, getSkeletalMeshBatch(skeletalMeshes, batchStart), slowTask, /*CanCancel*/false, skeletalMeshBoneEdits);
+    }
+
+    for (auto& skeletalMeshBoneEdit : skeletalMeshBoneEdits)
+    {
+      USkeletalMesh* skeletalMesh = skeletalMeshBoneEdit.SkeletalMesh;
+
       { // add root bone
         FReferenceSkeleton referenceSkeleton;
         {
@@ -1184,11 +1416,11 @@ bool UTTToolboxBlueprintLibrary::AddRootBone(USkeleton* Skeleton)
           referenceSkeletonModifier.Add(meshRootBoneInfo, FTransform::Identity);
 
           // increase parent bone indices to sucessfully register the root bone
-          for (int32 ii = 0; ii < skeletalMesh->GetSkeleton()->GetReferenceSkeleton().GetRawBoneNum(); ii++)
+          for (int32 ii = 0; ii < skeletonReferenceSkeleton.GetRawBoneNum(); ii++)
           {
-            FMeshBoneInfo meshBoneInfo = skeletalMesh->GetSkeleton()->GetReferenceSkeleton().GetRawRefBoneInfo()[ii];
+            FMeshBoneInfo meshBoneInfo = skeletonReferenceSkeleton.GetRawRefBoneInfo()[ii];
             meshBoneInfo.ParentIndex++;
-            const auto boneRefPoseTransform = skeletalMesh->GetSkeleton()->GetReferenceSkeleton().GetRawRefBonePose()[ii];
+            const auto boneRefPoseTransform = skeletonReferenceSkeleton.GetRawRefBonePose()[ii];
             referenceSkeletonModifier.Add(meshBoneInfo, boneRefPoseTransform);
           }
         }
@@ -1200,124 +1432,44 @@ bool UTTToolboxBlueprintLibrary::AddRootBone(USkeleton* Skeleton)
       //! @todo clarify if this is still needed in 5.3 for adding root bones to the Mixamo Skeleton?
       //skeletalMesh->GetRetargetBasePose().Empty();
       skeletalMesh->CalculateInvRefMatrices();
+    }
 
-      uint32 LODIndex = 0;
-      for (FSkeletalMeshLODModel& skeletalMeshLODModel : skeletalMesh->GetImportedModel()->LODModels)
+    // Shift all bone indices of the import data. The import data are detached copies owned by the bone edits,
+    // so the skeletal meshes can be processed in parallel without touching any UObject.
+    slowTask.EnterProgressFrame(1.f, LOCTEXT("AddRootBoneToLODs", "Updating the bone indices of the LOD import data..."));
+    ParallelFor(skeletalMeshBoneEdits.Num(), [&skeletalMeshBoneEdits, &boneIndexRemap](int32 meshIndex)
+    {
+      CSkeletalMeshBoneEdit& skeletalMeshBoneEdit = skeletalMeshBoneEdits[meshIndex];
+      for (int32 LODIndex = 0; LODIndex < skeletalMeshBoneEdit.LODImportData.Num(); ++LODIndex)
       {
-        // increase active bone indices to sucessfully register the new root bone
-        for (auto& activeBoneIndex : skeletalMeshLODModel.ActiveBoneIndices)
+        if (skeletalMeshBoneEdit.HasLODImportData[LODIndex])
         {
-          activeBoneIndex++;
+          addRootBoneToImportData(skeletalMeshBoneEdit.LODImportData[LODIndex], boneIndexRemap);
         }
-        // insert root bone
-        skeletalMeshLODModel.ActiveBoneIndices.Insert(0, 0);
-
-        // increase required bone (unweighted bones) indices to sucessfully register the new root bone
-        for (auto& requiredBoneIndex : skeletalMeshLODModel.RequiredBones)
-        {
-          requiredBoneIndex++;
-        }
-        // insert root bone
-        skeletalMeshLODModel.RequiredBones.Insert(0, 0);
-
-        // update bone references used by the skin weights
-        for (auto& skinWeightsProfile : skeletalMeshLODModel.SkinWeightProfiles)
-        {
-          FImportedSkinWeightProfileData& importedSkinWeightProfileData = skeletalMeshLODModel.SkinWeightProfiles.FindChecked(skinWeightsProfile.Key);
-
-          // increase bone skin weight indices to sucessfully register the root bone
-          for (auto& skinWeight : importedSkinWeightProfileData.SkinWeights)
-          {
-            for (int32 ii = 0; ii < MAX_TOTAL_INFLUENCES; ii++)
-            {
-              if (skinWeight.InfluenceWeights[ii] > 0)
-              {
-                skinWeight.InfluenceBones[ii]++;
-              }
-            }
-          }
-
-          // increase source model influence bone indices to sucessfully register the root bone
-          for (auto& sourceModelInfluence : importedSkinWeightProfileData.SourceModelInfluences)
-          {
-            if (sourceModelInfluence.Weight > 0)
-            {
-              sourceModelInfluence.BoneIndex++;
-            }
-          }
-        }
-
-        // adapt LOD sections
-#if ENGINE_MAJOR_VERSION ==	5 &&  ENGINE_MINOR_VERSION <= 3
-        if (skeletalMesh->IsLODImportedDataBuildAvailable(LODIndex) && !skeletalMesh->IsLODImportedDataEmpty(LODIndex))
-#elif ENGINE_MAJOR_VERSION ==	5 &&  ENGINE_MINOR_VERSION > 3
-        if (skeletalMesh->HasMeshDescription(LODIndex))
-#endif
-        {
-          FSkeletalMeshImportData skeletalMeshImportData;
-#if ENGINE_MAJOR_VERSION ==	5 &&  ENGINE_MINOR_VERSION <= 3
-          skeletalMesh->LoadLODImportedData(LODIndex, skeletalMeshImportData);
-#elif ENGINE_MAJOR_VERSION ==	5 &&  ENGINE_MINOR_VERSION > 3
-          if (const FMeshDescription* MeshDescription = skeletalMesh->GetMeshDescription(LODIndex))
-          {
-            skeletalMeshImportData = FSkeletalMeshImportData::CreateFromMeshDescription(*MeshDescription);
-          }
-#endif
-
-          // increase parent indices to sucessfully add the new root bone
-          int32 numRootBoneChilds = 0;
-          for (auto& referenceBoneBinary : skeletalMeshImportData.RefBonesBinary)
-          {
-            if (referenceBoneBinary.ParentIndex == INDEX_NONE)
-            {
-              numRootBoneChilds += referenceBoneBinary.NumChildren;
-            }
-            referenceBoneBinary.ParentIndex++;
-          }
-
-          const SkeletalMeshImportData::FJointPos rootBonePosition = { FTransform3f::Identity, 1.f, 100.f, 100.f, 100.f };
-          const SkeletalMeshImportData::FBone rootBone = { gs_rootBoneName.ToString(), 0, numRootBoneChilds, INDEX_NONE, rootBonePosition };
-          skeletalMeshImportData.RefBonesBinary.Insert(rootBone, 0);
-
-          // increase bone influences to sucessfully add the new root bone
-          for (auto& influence : skeletalMeshImportData.Influences)
-          {
-            influence.BoneIndex++;
-          }
+      }
+    });
 
-          if (skeletalMeshImportData.MorphTargets.Num() > 0)
-          {
-            //! @todo @ffs is it possible to support morph targets?
-            UE_LOG(LogTemp, Warning, TEXT("MorphTargets are currently not supported."));
-          }
+    // commit the changes of each skeletal mesh, the LOD models and the engine APIs used here need to be accessed on the game thread
+    for (auto& skeletalMeshBoneEdit : skeletalMeshBoneEdits)
+    {
+      USkeletalMesh* skeletalMesh = skeletalMeshBoneEdit.SkeletalMesh;
+      slowTask.EnterProgressFrame(1.f, FText::Format(LOCTEXT("CommitSkeletalMesh", "Updating {0}..."), FText::FromString(skeletalMesh->GetName())));
 
-          if (skeletalMeshImportData.AlternateInfluences.Num() > 0)
-          {
-            //! @todo @ffs is it possible to support alternate influences?
-            UE_LOG(LogTemp, Warning, TEXT("AlternateInfluences are currently not supported."));
-          }
+      uint32 LODIndex = 0;
+      for (FSkeletalMeshLODModel& skeletalMeshLODModel : skeletalMesh->GetImportedModel()->LODModels)
+      {
+        // the section bone maps are rebuilt from the import data if available
+        boneIndexRemap.ApplyToLODModel(skeletalMeshLODModel, !skeletalMeshBoneEdit.HasLODImportData[LODIndex]);
 
-#if ENGINE_MAJOR_VERSION ==	5 &&  ENGINE_MINOR_VERSION <= 3
-          skeletalMesh->SaveLODImportedData(LODIndex, skeletalMeshImportData);
-#elif ENGINE_MAJOR_VERSION ==	5 &&  ENGINE_MINOR_VERSION > 3
-          skeletalMesh->CommitMeshDescription(LODIndex);
-#endif
-        }
-        else
-        {
-          for (auto& LODSection : skeletalMeshLODModel.Sections)
-          {
-            // increase bone indices to sucessfully register the new root bone
-            for (auto& boneIndex : LODSection.BoneMap)
-            {
-              boneIndex++;
-            }
-          }
-        }
+        // insert root bone
+        skeletalMeshLODModel.ActiveBoneIndices.Insert(0, 0);
+        skeletalMeshLODModel.RequiredBones.Insert(0, 0);
 
         ++LODIndex;
       }
 
+      saveLODImportData(skeletalMeshBoneEdit);
+
       if (modifiedSkeletalMeshes == 0)
       {
         if (!(Skeleton->RecreateBoneTree(skeletalMesh)))
@@ -1401,7 +1553,7 @@ bool UTTToolboxBlueprintLibrary::UpdateControlRigBlueprintPreviewMesh(UControlRi
     return true;
 }
 
-bool UTTToolboxBlueprintLibrary::CopyAnimMontageCurves(UAnimMontage* SourceAnimMontage, UAnimMontage* TargetAnimMontage)
+bool UTTToolboxBlueprintLibrary::CopyAnimMontageCurves(UAnimMontage* SourceAnimMontage, UAnimMontage* TargetAnimMontage, const FTTCurveCopyOptions& CurveCopyOptions)
 {
   // check input arguments
   if (!IsValid(SourceAnimMontage) || !IsValid(TargetAnimMontage))
@@ -1411,23 +1563,81 @@ bool UTTToolboxBlueprintLibrary::CopyAnimMontageCurves(UAnimMontage* SourceAnimM
   }
 
   // curves should be copied over so all existing curves need to be removed
-  auto& targetController = TargetAnimMontage->GetController();
-  targetController.RemoveAllCurvesOfType(ERawCurveTrackTypes::RCT_Float);
+  return CopyAnimMontageCurvesToTargets(SourceAnimMontage, { TargetAnimMontage }, CurveCopyOptions, /*MergeCurves*/false);
+}
 
-  for (auto& sourceCurve : SourceAnimMontage->GetCurveData().FloatCurves)
+bool UTTToolboxBlueprintLibrary::CopyAnimMontageCurvesToTargets(UAnimMontage* SourceAnimMontage, const TArray<UAnimMontage*>& TargetAnimMontages, const FTTCurveCopyOptions& CurveCopyOptions, bool MergeCurves)
+{
+  // check input arguments
+  if (!IsValid(SourceAnimMontage))
   {
-    const FAnimationCurveIdentifier curveId(sourceCurve.GetName(), ERawCurveTrackTypes::RCT_Float);
-    targetController.AddCurve(curveId);
-    targetController.SetCurveKeys(curveId, sourceCurve.FloatCurve.GetConstRefOfKeys());
+    UE_LOG(LogTemp, Error, TEXT("Called \"CopyAnimMontageCurvesToTargets\" with invalid SourceAnimMontage."));
+    return false;
   }
 
-  // modify the TargetAnimMontage
-  TargetAnimMontage->Modify();
+  bool hasInvalidTargets = false;
+  TArray<UAnimMontage*> targetAnimMontages;
+  targetAnimMontages.Reserve(TargetAnimMontages.Num());
+  for (auto targetAnimMontage : TargetAnimMontages)
+  {
+    if (!IsValid(targetAnimMontage) || targetAnimMontage == SourceAnimMontage)
+    {
+      UE_LOG(LogTemp, Error, TEXT("Called \"CopyAnimMontageCurvesToTargets\" with an invalid target or the source as target, which will be skipped."));
+      hasInvalidTargets = true;
+      continue;
+    }
 
-  return true;
+    targetAnimMontages.Add(targetAnimMontage);
+  }
+
+  // the prepared keys only depend on the frame rate and length of the target if the keys are resampled,
+  // so targets with the same timing share the same prepared keys
+  const TArray<FFloatCurve>& sourceCurves = SourceAnimMontage->GetCurveData().FloatCurves;
+  TArray<CPreparedCurveKeys> preparedCurveKeys;
+  TArray<int32> targetPreparedCurveKeyIndices;
+  targetPreparedCurveKeyIndices.Reserve(targetAnimMontages.Num());
+  for (auto targetAnimMontage : targetAnimMontages)
+  {
+    const IAnimationDataModel* targetDataModel = targetAnimMontage->GetDataModel();
+    const FFrameRate frameRate = CurveCopyOptions.ResampleToTargetFrameRate ? targetDataModel->GetFrameRate() : FFrameRate();
+    const double playLength = CurveCopyOptions.ResampleToTargetFrameRate ? targetDataModel->GetPlayLength() : 0.0;
+
+    int32 preparedCurveKeyIndex = preparedCurveKeys.IndexOfByPredicate([&](const CPreparedCurveKeys& PreparedKeys)
+    {
+      return PreparedKeys.FrameRate == frameRate && PreparedKeys.PlayLength == playLength;
+    });
+
+    if (preparedCurveKeyIndex == INDEX_NONE)
+    {
+      preparedCurveKeyIndex = preparedCurveKeys.Num();
+      CPreparedCurveKeys& preparedKeys = preparedCurveKeys.AddDefaulted_GetRef();
+      preparedKeys.FrameRate = frameRate;
+      preparedKeys.PlayLength = playLength;
+      preparedKeys.Keys.SetNum(sourceCurves.Num());
+    }
+
+    targetPreparedCurveKeyIndices.Add(preparedCurveKeyIndex);
+  }
+
+  // prepare the keys of all curves in parallel, the source curves are only read
+  const int32 numCurves = sourceCurves.Num();
+  ParallelFor(preparedCurveKeys.Num() * numCurves, [&](int32 Index)
+  {
+    CPreparedCurveKeys& preparedKeys = preparedCurveKeys[Index / numCurves];
+    const int32 curveIndex = Index % numCurves;
+    CCurveUtils::PrepareKeys(sourceCurves[curveIndex].FloatCurve, CurveCopyOptions, preparedKeys.FrameRate, preparedKeys.PlayLength, preparedKeys.Keys[curveIndex]);
+  });
+
+  // the data model edits need to happen on the game thread
+  for (int32 targetIndex = 0; targetIndex < targetAnimMontages.Num(); targetIndex++)
+  {
+    copyCurvesToAnimMontage(targetAnimMontages[targetIndex], sourceCurves, preparedCurveKeys[targetPreparedCurveKeyIndices[targetIndex]].Keys, MergeCurves);
+  }
+
+  return !hasInvalidTargets;
 }
 
-bool UTTToolboxBlueprintLibrary::DumpIKChains(const UIKRigDefinition* IKRigDefinition)
+bool UTTToolboxBlueprintLibrary::DumpIKChains(const UIKRigDefinition* IKRigDefinition, const FString& FilePath)
 {
   // check input arguments
   if (!IsValid(IKRigDefinition))
@@ -1442,11 +1652,17 @@ bool UTTToolboxBlueprintLibrary::DumpIKChains(const UIKRigDefinition* IKRigDefin
     return false;
   }
 
-  // prepare the dump string
-  FString dumpString;
+  TUniquePtr<FArchive> fileArchive;
+  if (!beginDump(FilePath, fileArchive))
+  {
+    return false;
+  }
+
+  // prepare the dump text
+  CTextWriter writer(IKRigDefinition->GetRetargetChains().Num() * 192 + 2, fileArchive.Get());
   if (IKRigDefinition->GetRetargetChains().Num() > 1)
   {
-    dumpString += "(";
+    writer.Append(TEXT('('));
   }
 
   // iterate over all IK chains
@@ -1455,46 +1671,25 @@ bool UTTToolboxBlueprintLibrary::DumpIKChains(const UIKRigDefinition* IKRigDefin
   {
     if (count > 0)
     {
-      dumpString += ",";
+      writer.Append(TEXT(','));
     }
 
-    dumpString += "(";
+    writer.Append(TEXT("(ChainName=")).AppendQuoted(boneChain.ChainName);
+    writer.Append(TEXT(",StartBone=")).AppendQuoted(boneChain.StartBone.BoneName);
+    writer.Append(TEXT(",EndBone=")).AppendQuoted(boneChain.EndBone.BoneName);
+    writer.Append(TEXT(",IKGoalName=")).AppendQuoted(boneChain.IKGoalName);
+    writer.Append(TEXT(')'));
 
-    dumpString += "ChainName=\"";
-    dumpString += boneChain.ChainName.ToString();
-    dumpString += "\",";
-
-    dumpString += "StartBone=\"";
-    dumpString += boneChain.StartBone.BoneName.ToString();
-    dumpString += "\",";
-
-    dumpString += "EndBone=\"";
-    dumpString += boneChain.EndBone.BoneName.ToString();
-    dumpString += "\",";
-
-    dumpString += "IKGoalName=\"";
-    dumpString += boneChain.IKGoalName.ToString();
-    dumpString += "\"";
-
-    dumpString += ")";
-
-    count++;
-  }
+    count++;
+  }
 
   if (IKRigDefinition->GetRetargetChains().Num() > 1)
   {
-    dumpString += ")";
+    writer.Append(TEXT(')'));
   }
 
-  // print the IK chains to the log
-  UE_LOG(LogTemp, Log, TEXT("%s"), *dumpString);
-
-  // store the IK chains in the clipboard
-#if WITH_EDITOR
-  FPlatformApplicationMisc::ClipboardCopy(*dumpString);
-#endif
-
-  return true;
+  // print the IK chains to the log and store them in the clipboard or the file
+  return finishDump(writer, fileArchive.Get(), FilePath);
 }
 
 bool UTTToolboxBlueprintLibrary::AddIKBoneChains(UIKRigDefinition* IKRigDefinition, const TArray<FBoneChain_BP>& BoneChains)
@@ -1577,41 +1772,469 @@ bool UTTToolboxBlueprintLibrary::SetIKBoneChainGoal(UIKRigDefinition* IKRigDefin
 }
 
 // helper function implementations
-FString FVectorToString(const FVector& Vector)
+static bool beginDump(const FString& FilePath, TUniquePtr<FArchive>& OutFileArchive)
 {
-  FString str = "X=";
-  str += FString::SanitizeFloat(Vector.X);
-  str += ",Y=";
-  str += FString::SanitizeFloat(Vector.Y);
-  str += ",Z=";
-  str += FString::SanitizeFloat(Vector.Z);
-
-  return str;
+  // without a file path the dump is written to the log and the clipboard
+  if (FilePath.IsEmpty())
+  {
+    return true;
+  }
+
+  OutFileArchive = CTextWriter::CreateFileArchive(FilePath);
+  return OutFileArchive.IsValid();
+}
+
+static bool finishDump(CTextWriter& Writer, FArchive* FileArchive, const FString& FilePath)
+{
+  if (FileArchive != nullptr)
+  {
+    Writer.Flush();
+    if (!FileArchive->Close())
+    {
+      UE_LOG(LogTemp, Error, TEXT("Failed to write the dump to \"%s\"."), *FilePath);
+      return false;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("Dump written to \"%s\"."), *FilePath);
+    return true;
+  }
+
+  // log lines are limited in length, that's why the dump is split into multiple lines
+  Writer.LogChunked();
+
+#if WITH_EDITOR
+  FPlatformApplicationMisc::ClipboardCopy(*Writer.GetText());
+#endif
+
+  return true;
 }
 
 static TArray<USkeletalMesh*> getAllSkeletalMeshes(USkeleton* Skeleton)
 {
   check(IsValid(Skeleton));
 
-  TArray<USkeletalMesh*> skeletalMeshes;
+  // the skeletal meshes are looked up in the cached index and loaded in batches
+  return CSkeletalMeshRegistry::Get().LoadSkeletalMeshes(Skeleton);
+}
+
+static TArray<FSoftObjectPath> getAnimSequencePaths(USkeleton* Skeleton)
+{
+  check(IsValid(Skeleton));
 
+  // filter on the registry tag of the skeleton property, so only the matching animation sequences are loaded later
   FARFilter filter;
-  filter.ClassPaths.Add(USkeletalMesh::StaticClass()->GetClassPathName());
+  filter.ClassPaths.Add(UAnimSequence::StaticClass()->GetClassPathName());
   filter.bRecursiveClasses = true;
-  const FString skeletonString = FAssetData(Skeleton).GetExportTextName();
-  filter.TagsAndValues.Add(USkeletalMesh::GetSkeletonMemberName(), skeletonString);
-  FAssetRegistryModule& assetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
+  filter.TagsAndValues.Add(TEXT("Skeleton"), FAssetData(Skeleton).GetExportTextName());
 
   TArray<FAssetData> assets;
-  assetRegistryModule.Get().GetAssets(filter, assets);
+  IAssetRegistry& assetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+  assetRegistry.GetAssets(filter, assets);
 
+  TArray<FSoftObjectPath> animSequencePaths;
+  animSequencePaths.Reserve(assets.Num());
   for (auto& asset : assets)
   {
-    if (auto skeletalMesh = Cast<USkeletalMesh>(asset.GetAsset()))
+    animSequencePaths.Add(asset.GetSoftObjectPath());
+  }
+
+  return animSequencePaths;
+}
+
+static TArrayView<USkeletalMesh* const> getSkeletalMeshBatch(const TArray<USkeletalMesh*>& SkeletalMeshes, int32 BatchStart)
+{
+  return MakeArrayView(SkeletalMeshes).Slice(BatchStart, FMath::Min(gs_skeletalMeshBatchSize, SkeletalMeshes.Num() - BatchStart));
+}
+
+static bool prepareSkeletalMeshBoneEdits(USkeleton* Skeleton, TArrayView<USkeletalMesh* const> SkeletalMeshes, FScopedSlowTask& SlowTask, bool CanCancel, TArray<CSkeletalMeshBoneEdit>& OutSkeletalMeshBoneEdits)
+{
+  check(IsValid(Skeleton));
+
+  OutSkeletalMeshBoneEdits.Reset(SkeletalMeshes.Num());
+  for (auto skeletalMesh : SkeletalMeshes)
+  {
+    SlowTask.EnterProgressFrame(1.f, FText::Format(LOCTEXT("PrepareSkeletalMesh", "Loading import data of {0}..."), FText::FromString(skeletalMesh->GetName())));
+    if (CanCancel && SlowTask.ShouldCancel())
+    {
+      OutSkeletalMeshBoneEdits.Empty();
+      return false;
+    }
+
+    if (Skeleton != skeletalMesh->GetSkeleton())
+    {
+      continue;
+    }
+
+    CSkeletalMeshBoneEdit& skeletalMeshBoneEdit = OutSkeletalMeshBoneEdits.AddDefaulted_GetRef();
+    skeletalMeshBoneEdit.SkeletalMesh = skeletalMesh;
+
+    const int32 numLODs = skeletalMesh->GetImportedModel()->LODModels.Num();
+    skeletalMeshBoneEdit.LODImportData.SetNum(numLODs);
+    skeletalMeshBoneEdit.HasLODImportData.Init(false, numLODs);
+    for (int32 LODIndex = 0; LODIndex < numLODs; ++LODIndex)
+    {
+#if ENGINE_MAJOR_VERSION ==	5 &&  ENGINE_MINOR_VERSION <= 3
+      if (skeletalMesh->IsLODImportedDataBuildAvailable(LODIndex) && !skeletalMesh->IsLODImportedDataEmpty(LODIndex))
+      {
+        skeletalMesh->LoadLODImportedData(LODIndex, skeletalMeshBoneEdit.LODImportData[LODIndex]);
+        skeletalMeshBoneEdit.HasLODImportData[LODIndex] = true;
+      }
+#elif ENGINE_MAJOR_VERSION ==	5 &&  ENGINE_MINOR_VERSION > 3
+      if (skeletalMesh->HasMeshDescription(LODIndex))
+      {
+        if (const FMeshDescription* MeshDescription = skeletalMesh->GetMeshDescription(LODIndex))
+        {
+          skeletalMeshBoneEdit.LODImportData[LODIndex] = FSkeletalMeshImportData::CreateFromMeshDescription(*MeshDescription);
+          skeletalMeshBoneEdit.HasLODImportData[LODIndex] = true;
+        }
+      }
+#endif
+    }
+  }
+
+  return true;
+}
+
+static void saveLODImportData(CSkeletalMeshBoneEdit& SkeletalMeshBoneEdit)
+{
+  USkeletalMesh* skeletalMesh = SkeletalMeshBoneEdit.SkeletalMesh;
+  for (int32 LODIndex = 0; LODIndex < SkeletalMeshBoneEdit.HasLODImportData.Num(); ++LODIndex)
+  {
+    if (!SkeletalMeshBoneEdit.HasLODImportData[LODIndex])
+    {
+      continue;
+    }
+
+#if ENGINE_MAJOR_VERSION ==	5 &&  ENGINE_MINOR_VERSION <= 3
+    skeletalMesh->SaveLODImportedData(LODIndex, SkeletalMeshBoneEdit.LODImportData[LODIndex]);
+#elif ENGINE_MAJOR_VERSION ==	5 &&  ENGINE_MINOR_VERSION > 3
+    skeletalMesh->CommitMeshDescription(LODIndex);
+#endif
+  }
+}
+
+static void addRootBoneToImportData(FSkeletalMeshImportData& ImportData, const CBoneIndexRemap& BoneIndexRemap)
+{
+  BoneIndexRemap.ApplyToImportData(ImportData);
+
+  // morph targets and alternate influences provide their own reference bones (if any), which
+  // are shifted in the same way, so the mesh can be rebuilt without reimporting the source file
+  for (FSkeletalMeshImportData& morphTargetImportData : ImportData.MorphTargets)
+  {
+    addRootBoneToImportData(morphTargetImportData, BoneIndexRemap);
+  }
+  for (FSkeletalMeshImportData& alternateInfluenceImportData : ImportData.AlternateInfluences)
+  {
+    addRootBoneToImportData(alternateInfluenceImportData, BoneIndexRemap);
+  }
+
+  // import data without reference bones references the bones of its owner
+  if (ImportData.RefBonesBinary.Num() == 0)
+  {
+    return;
+  }
+
+  // the former root bones become children of the new root bone
+  int32 numRootBoneChilds = 0;
+  for (auto& referenceBoneBinary : ImportData.RefBonesBinary)
+  {
+    if (referenceBoneBinary.ParentIndex == INDEX_NONE)
+    {
+      numRootBoneChilds++;
+      referenceBoneBinary.ParentIndex = 0;
+    }
+  }
+
+  const SkeletalMeshImportData::FJointPos rootBonePosition = { FTransform3f::Identity, 1.f, 100.f, 100.f, 100.f };
+  const SkeletalMeshImportData::FBone rootBone = { gs_rootBoneName.ToString(), 0, numRootBoneChilds, INDEX_NONE, rootBonePosition };
+  ImportData.RefBonesBinary.Insert(rootBone, 0);
+}
+
+static bool hasVirtualBone(USkeleton* Skeleton, const FName& VirtualBoneName)
+{
+  for (auto& virtualBone : Skeleton->GetVirtualBones())
+  {
+    if (virtualBone.VirtualBoneName == VirtualBoneName)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+static bool validateIntegrationProfile(USkeleton* Skeleton, const FTTIntegrationProfile& IntegrationProfile)
+{
+  const FReferenceSkeleton& referenceSkeleton = Skeleton->GetReferenceSkeleton();
+  bool isValid = true;
+
+  // sockets can be attached to the virtual bones that are added by the profile itself
+  TSet<FName> profileVirtualBoneNames;
+  for (auto& virtualBone : IntegrationProfile.VirtualBones)
+  {
+    profileVirtualBoneNames.Add(virtualBone.VirtualBoneName);
+  }
+
+  for (auto& virtualBone : IntegrationProfile.VirtualBones)
+  {
+    if (virtualBone.VirtualBoneName.IsNone() || virtualBone.SourceBoneName.IsNone() || virtualBone.TargetBoneName.IsNone())
+    {
+      UE_LOG(LogTemp, Error, TEXT("The virtual bone \"%s\" (source = %s, target = %s) contains an invalid name (\"None\")."),
+        *virtualBone.VirtualBoneName.ToString(), *virtualBone.SourceBoneName.ToString(), *virtualBone.TargetBoneName.ToString());
+      isValid = false;
+      continue;
+    }
+
+    if (referenceSkeleton.FindBoneIndex(virtualBone.SourceBoneName) == INDEX_NONE || referenceSkeleton.FindBoneIndex(virtualBone.TargetBoneName) == INDEX_NONE)
+    {
+      UE_LOG(LogTemp, Error, TEXT("Skeleton \"%s\" does not provide the source bone \"%s\" or target bone \"%s\" of the virtual bone \"%s\"."),
+        *Skeleton->GetPathName(), *virtualBone.SourceBoneName.ToString(), *virtualBone.TargetBoneName.ToString(), *virtualBone.VirtualBoneName.ToString());
+      isValid = false;
+    }
+  }
+
+  for (auto& socket : IntegrationProfile.Sockets)
+  {
+    if (socket.SocketName.IsNone() || socket.BoneName.IsNone())
+    {
+      UE_LOG(LogTemp, Error, TEXT("The socket \"%s\" (bone = %s) contains an invalid name (\"None\")."), *socket.SocketName.ToString(), *socket.BoneName.ToString());
+      isValid = false;
+      continue;
+    }
+
+    if (referenceSkeleton.FindBoneIndex(socket.BoneName) == INDEX_NONE && !hasVirtualBone(Skeleton, socket.BoneName) && !profileVirtualBoneNames.Contains(socket.BoneName))
+    {
+      UE_LOG(LogTemp, Error, TEXT("Skeleton \"%s\" does not provide the bone \"%s\" of the socket \"%s\"."),
+        *Skeleton->GetPathName(), *socket.BoneName.ToString(), *socket.SocketName.ToString());
+      isValid = false;
+    }
+  }
+
+  for (auto& skeletonCurve : IntegrationProfile.SkeletonCurves)
+  {
+    if (skeletonCurve.CurveName.IsNone())
+    {
+      UE_LOG(LogTemp, Error, TEXT("The integration profile contains an invalid skeleton curve name (\"None\")."));
+      isValid = false;
+    }
+  }
+
+  for (auto& blendProfile : IntegrationProfile.BlendProfiles)
+  {
+    if (blendProfile.Key.IsNone())
+    {
+      UE_LOG(LogTemp, Error, TEXT("The integration profile contains an invalid blend profile name (\"None\")."));
+      isValid = false;
+      continue;
+    }
+
+    if (!IntegrationProfile.OverwriteBlendProfiles && Skeleton->GetBlendProfile(blendProfile.Key) != nullptr)
+    {
+      UE_LOG(LogTemp, Error, TEXT("The blend profile \"%s\" does already exist in Skeleton \"%s\" and \"OverwriteBlendProfiles\" is false."),
+        *blendProfile.Key.ToString(), *Skeleton->GetPathName());
+      isValid = false;
+    }
+
+    for (auto& blendEntry : blendProfile.Value.BlendValues)
+    {
+      if (referenceSkeleton.FindBoneIndex(blendEntry.Key) == INDEX_NONE)
+      {
+        UE_LOG(LogTemp, Error, TEXT("The bone name \"%s\" of the blend profile \"%s\" does not exist in Skeleton \"%s\"."),
+          *blendEntry.Key.ToString(), *blendProfile.Key.ToString(), *Skeleton->GetPathName());
+        isValid = false;
+      }
+    }
+  }
+
+  for (auto& slotGroup : IntegrationProfile.SlotGroups)
+  {
+    if (slotGroup.GroupName.IsNone() || slotGroup.SlotNames.Contains(NAME_None))
+    {
+      UE_LOG(LogTemp, Error, TEXT("The slot group \"%s\" contains an invalid name (\"None\")."), *slotGroup.GroupName.ToString());
+      isValid = false;
+    }
+  }
+
+  return isValid;
+}
+
+static bool addVirtualBone(USkeleton* Skeleton, const FName& VirtualBoneName, const FName& SourceBoneName, const FName& TargetBoneName)
+{
+  FName newVirtualBoneName = VirtualBoneName;
+  if (!Skeleton->AddNewVirtualBone(SourceBoneName, TargetBoneName, newVirtualBoneName))
+  {
+    UE_LOG(LogTemp, Error, TEXT("Failed to add virtual bone in skeleton \"%s\"."), *(Skeleton->GetFullName()));
+    return false;
+  }
+  Skeleton->RenameVirtualBone(newVirtualBoneName, VirtualBoneName);
+
+  return true;
+}
+
+static void restoreVirtualBones(USkeleton* Skeleton, const TArray<FVirtualBone>& VirtualBones)
+{
+  TArray<FName> virtualBoneNames;
+  for (auto& virtualBone : Skeleton->GetVirtualBones())
+  {
+    virtualBoneNames.Add(virtualBone.VirtualBoneName);
+  }
+  if (virtualBoneNames.Num() > 0)
+  {
+    Skeleton->RemoveVirtualBones(virtualBoneNames);
+  }
+
+  // the order of the skeleton keeps the source and target virtual bones in front of the virtual bones built on top of them
+  for (auto& virtualBone : VirtualBones)
+  {
+    addVirtualBone(Skeleton, virtualBone.VirtualBoneName, virtualBone.SourceBoneName, virtualBone.TargetBoneName);
+  }
+}
+
+static void addSocket(USkeleton* Skeleton, const FName& BoneName, const FName& SocketName, const FTransform& RelativeTransform)
+{
+  auto socket = NewObject<USkeletalMeshSocket>(Skeleton);
+  socket->SocketName = SocketName;
+  setSocket(socket, BoneName, RelativeTransform);
+  Skeleton->Sockets.Add(socket);
+}
+
+static void setSocket(USkeletalMeshSocket* Socket, const FName& BoneName, const FTransform& RelativeTransform)
+{
+  Socket->BoneName = BoneName;
+  Socket->RelativeLocation = RelativeTransform.GetLocation();
+  Socket->RelativeRotation = RelativeTransform.GetRotation().Rotator();
+  Socket->RelativeScale = RelativeTransform.GetScale3D();
+}
+
+static bool addSkeletonCurve(USkeleton* Skeleton, const FTTSkeletonCurve_BP& SkeletonCurve, bool OverwriteFlags)
+{
+  // the caller is responsible for the transaction and the change notification
+  const bool isAdded = Skeleton->AddCurveMetaData(SkeletonCurve.CurveName, /*bTransact*/false);
+
+  if (FCurveMetaData* curveMetaData = Skeleton->GetCurveMetaData(SkeletonCurve.CurveName))
+  {
+    if (OverwriteFlags)
+    {
+      curveMetaData->Type.bMaterial = SkeletonCurve.Material;
+      curveMetaData->Type.bMorphtarget = SkeletonCurve.MorphTarget;
+    }
+    else
+    {
+      curveMetaData->Type.bMaterial |= SkeletonCurve.Material;
+      curveMetaData->Type.bMorphtarget |= SkeletonCurve.MorphTarget;
+    }
+  }
+
+  return isAdded;
+}
+
+static void setBlendProfile(USkeleton* Skeleton, const FName& BlendProfileName, const FTTBlendProfile_BP& BlendProfile)
+{
+  // in case a blend profile was not found a new blend profile is created
+  auto blendProfile = Skeleton->GetBlendProfile(BlendProfileName);
+  if (!blendProfile)
+  {
+    blendProfile = Skeleton->CreateNewBlendProfile(BlendProfileName);
+  }
+
+  // fill out blend profile with it's values
+  blendProfile->Mode = BlendProfile.BlendProfileMode;
+
+  blendProfile->ProfileEntries.Empty(BlendProfile.BlendValues.Num());
+  for (auto& blendEntry : BlendProfile.BlendValues)
+  {
+    int32 boneIndex = Skeleton->GetReferenceSkeleton().FindBoneIndex(blendEntry.Key);
+    if (boneIndex == INDEX_NONE)
+    {
+      UE_LOG(LogTemp, Error, TEXT("The bone name \"%s\" did not exist in Skeleton \"%s\" while trying to add the blend profile \"%s\"."),
+        *blendEntry.Key.ToString(), *Skeleton->GetPathName(), *BlendProfileName.ToString());
+      continue;
+    }
+
+    blendProfile->SetBoneBlendScale(blendEntry.Key, blendEntry.Value, false, true);
+  }
+}
+
+static void addSlotGroup(USkeleton* Skeleton, const FTTMontageSlotGroup& SlotGroup)
+{
+  auto slotGroup = Skeleton->FindAnimSlotGroup(SlotGroup.GroupName);
+  if (!slotGroup)
+  {
+    (void)Skeleton->AddSlotGroupName(SlotGroup.GroupName); // do not process the return value or raise any warning
+    slotGroup = Skeleton->FindAnimSlotGroup(SlotGroup.GroupName);
+  }
+
+  for (int32 ii = 0; ii < SlotGroup.SlotNames.Num(); ii++)
+  {
+    if (SlotGroup.SlotNames[ii].IsNone())
+    {
+      UE_LOG(LogTemp, Error, TEXT("The slot group \"%s\" did contain a invalid slot name (\"None\") at index %i."), *SlotGroup.GroupName.ToString(), ii);
+      continue;
+    }
+
+    slotGroup->SlotNames.AddUnique(SlotGroup.SlotNames[ii]);
+  }
+}
+
+static void diffCurveNames(const TArray<FName>& ReferenceCurveNames, const TSet<FName>& ReferenceCurveNameSet, USkeleton* Skeleton, FTTCurveDiff_BP& OutCurveDiff)
+{
+  TArray<FName> skeletonCurveNames;
+  Skeleton->GetCurveMetaDataNames(skeletonCurveNames);
+  const TSet<FName> skeletonCurveNameSet(skeletonCurveNames);
+
+  OutCurveDiff.Skeleton = Skeleton;
+  OutCurveDiff.MissingCurves.Reset();
+  OutCurveDiff.CommonCurves.Reset(FMath::Min(ReferenceCurveNames.Num(), skeletonCurveNames.Num()));
+  OutCurveDiff.ExtraCurves.Reset();
+
+  for (auto& curveName : ReferenceCurveNames)
+  {
+    if (skeletonCurveNameSet.Contains(curveName))
+    {
+      OutCurveDiff.CommonCurves.Add(curveName);
+    }
+    else
     {
-      skeletalMeshes.Add(skeletalMesh);
+      OutCurveDiff.MissingCurves.Add(curveName);
     }
   }
 
-  return skeletalMeshes;
+  for (auto& curveName : skeletonCurveNames)
+  {
+    if (!ReferenceCurveNameSet.Contains(curveName))
+    {
+      OutCurveDiff.ExtraCurves.Add(curveName);
+    }
+  }
 }
+
+static void copyCurvesToAnimMontage(UAnimMontage* TargetAnimMontage, const TArray<FFloatCurve>& SourceCurves, const TArray<TArray<FRichCurveKey>>& CurveKeys, bool MergeCurves)
+{
+  const IAnimationDataModel* targetDataModel = TargetAnimMontage->GetDataModel();
+  auto& targetController = TargetAnimMontage->GetController();
+
+  {
+    // all edits of the target are batched into a single bracket
+    IAnimationDataController::FScopedBracket scopedBracket(targetController, LOCTEXT("CopyAnimMontageCurves", "Copy Anim Montage Curves"));
+
+    if (!MergeCurves)
+    {
+      targetController.RemoveAllCurvesOfType(ERawCurveTrackTypes::RCT_Float);
+    }
+
+    for (int32 curveIndex = 0; curveIndex < SourceCurves.Num(); curveIndex++)
+    {
+      const FAnimationCurveIdentifier curveId(SourceCurves[curveIndex].GetName(), ERawCurveTrackTypes::RCT_Float);
+      if (!MergeCurves || targetDataModel->FindFloatCurve(curveId) == nullptr)
+      {
+        targetController.AddCurve(curveId);
+      }
+
+      targetController.SetCurveKeys(curveId, CurveKeys[curveIndex]);
+    }
+  }
+
+  // modify the TargetAnimMontage
+  TargetAnimMontage->Modify();
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -37,6 +37,26 @@ struct TTTOOLBOX_API FConstraintBone
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Constraint)
 	FName ModifiedBone = NAME_None;
+
+	// copies the translation of the constraint bone to the modified bone
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Channels)
+	bool Translation = true;
+
+	// copies the rotation of the constraint bone to the modified bone
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Channels)
+	bool Rotation = true;
+
+	// copies the scale of the constraint bone to the modified bone
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Channels)
+	bool Scale = true;
+
+	// blends between the current pose of the modified bone (0) and the constrained pose (1)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Channels, meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float Alpha = 1.f;
+
+	// keeps the offset between the modified bone and the constraint bone of the reference pose
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Channels)
+	bool MaintainOffset = false;
 };
 
 UCLASS(EditInlineNew)
@@ -52,6 +72,11 @@ protected: // exposed members
 	UPROPERTY(EditAnywhere, Category = "Settings")
 	TArray<FConstraintBone> ConstraintBones;
 
+	// applies all constraints in hierarchy order and updates the affected bones in a single pass afterwards,
+	// instead of propagating the pose below each modified bone separately.
+	UPROPERTY(EditAnywhere, Category = "Settings")
+	bool BatchPropagation = true;
+
 protected: // UIKRigSolver interface
 	void Initialize(const FIKRigSkeleton& IKRigSkeleton) override;
 	void Solve(FIKRigSkeleton& IKRigSkeleton, const FIKRigGoalContainer& Goals) override;
@@ -69,10 +94,52 @@ protected: // UIKRigSolver interface
 #endif
 
 private:
+	void solveSequential(FIKRigSkeleton& IKRigSkeleton);
+	void solveBatched(FIKRigSkeleton& IKRigSkeleton);
+	// returns true if the bone has been modified by constraints, 'IsParentDirty' tells if the parent has been modified in the current solve
+	bool applyConstraintsOfBone(FIKRigSkeleton& IKRigSkeleton, int32 BoneIndex, bool IsParentDirty, int32& ConstraintIndex) const;
+	// returns true if every branch of the hierarchy is stored as contiguous index range
+	static bool isDepthFirstOrder(const TArray<int32>& ParentIndices);
+
+	// channel bits of 'CConstrainedBone::Channels'
+	static constexpr uint8 ChannelTranslation = 1 << 0;
+	static constexpr uint8 ChannelRotation = 1 << 1;
+	static constexpr uint8 ChannelScale = 1 << 2;
+	static constexpr uint8 ChannelsAll = ChannelTranslation | ChannelRotation | ChannelScale;
+
 	struct CConstrainedBone
 	{
 		int32 ConstraintBone = INDEX_NONE;
 		int32 ModifiedBone = INDEX_NONE;
+		uint8 Channels = ChannelsAll;
+		float Alpha = 1.f;
+		// offset of the modified bone relative to the constraint bone in the reference pose (identity if no offset is maintained)
+		FTransform Offset = FTransform::Identity;
+		// true if the global transform is copied as is, which does not need the current pose of the modified bone
+		bool IsFullCopy = true;
 	};
+
+	static void applyConstraint(FIKRigSkeleton& IKRigSkeleton, const CConstrainedBone& ConstrainedBone);
+	// sorted by the modified bone index, parents are always processed before their children
 	TArray<CConstrainedBone> m_constraintBones;
+
+	// Contiguous bone index range [First, Last] covering the modified bones and all of their children.
+	// Only used if the IK rig skeleton stores the bones depth first, which makes every branch a contiguous index range.
+	struct CDirtyRange
+	{
+		int32 First = INDEX_NONE;
+		int32 Last = INDEX_NONE;
+	};
+	// union of the branches of all modified bones, sorted and not overlapping
+	TArray<CDirtyRange> m_dirtyRanges;
+	// modified bones and all of their children
+	TBitArray<> m_dirtyBones;
+	// number of bones set in 'm_dirtyBones'
+	int32 m_numDirtyBones = 0;
+	// true if 'm_dirtyRanges' is valid, otherwise the solve tests 'm_dirtyBones' bone by bone
+	bool m_hasContiguousBranches = false;
+
+	// false if a constraint reads from a bone that gets modified earlier in the same solve,
+	// in that case the batched propagation would read stale transforms
+	bool m_canBatchPropagation = false;
 };
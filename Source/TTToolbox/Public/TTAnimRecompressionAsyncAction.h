@@ -0,0 +1,60 @@
+// The MIT License (MIT)
+// ---------------------
+// 
+// Copyright 2022 Achim Turan (https://www.instagram.com/tuatec/)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all copies or
+// substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "TTToolboxTypes.h"
+#include "TTAnimRecompressionAsyncAction.generated.h"
+
+// forward declarations
+class UAnimSequence;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FTTOnAnimSequencesRecompressed, const TArray<FTTAnimSequenceCompressionReport_BP>&, Reports);
+
+// Latent Blueprint node that recompresses animation sequences and waits until all compressions are finished.
+// The reports contain the compression time, a derived data cache hit heuristic and the compressed sizes per animation sequence.
+UCLASS()
+class TTTOOLBOX_API UTTAnimRecompressionAsyncAction : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+public:
+	// forces animation sequence recompression for the given 'AnimSequences' and triggers 'Completed' after all compressions have finished.
+	UFUNCTION(BlueprintCallable, Category = "TTToolbox", meta = (BlueprintInternalUseOnly = "true"))
+	static UTTAnimRecompressionAsyncAction* RequestAnimSequencesRecompressionAsync(const TArray<UAnimSequence*>& AnimSequences);
+
+	void Activate() override;
+
+	UPROPERTY(BlueprintAssignable)
+	FTTOnAnimSequencesRecompressed Completed;
+
+private:
+	void onCompleted(int32 NumCompressed);
+
+	// keeps the animation sequences alive until the compressions are finished
+	UPROPERTY()
+	TArray<TObjectPtr<UAnimSequence>> m_animSequences;
+
+	UPROPERTY()
+	TArray<FTTAnimSequenceCompressionReport_BP> m_reports;
+
+	double m_startTime = 0.0;
+};
@@ -22,6 +22,7 @@
 
 #include "CoreMinimal.h"
 #include "AnimationModifier.h"
+#include "TTToolboxTypes.h"
 #include "TTCopyAllCurvesAnimModifier.generated.h"
 
 UCLASS()
@@ -35,6 +36,10 @@ public: // members
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings")
 	UAnimSequence* SourceSequence = nullptr;
 
+	// removes all transform curves and all float curves of the target which are not part of the 'SourceSequence'
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings")
 	bool ReplaceExistingCurves = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings")
+	FTTCurveCopyOptions CurveCopyOptions;
 };
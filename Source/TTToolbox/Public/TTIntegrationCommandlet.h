@@ -0,0 +1,47 @@
+// The MIT License (MIT)
+// ---------------------
+// 
+// Copyright 2022 Achim Turan (https://www.instagram.com/tuatec/)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// associated documentation files (the "Software"), to deal in the Software without restriction,
+// including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all copies or
+// substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "TTIntegrationCommandlet.generated.h"
+
+// Applies the integration data tables (DT_VirtualBones, DT_Sockets, DT_UnweightedBones, DT_BlendProfiles, DT_SlotGroups,
+// DT_IKBoneChains and DT_SkeletonCurves) to a list of skeletons without the editor UI and saves the modified packages.
+//
+// Usage:
+// UnrealEditor-Cmd <Project>.uproject -run=TTIntegration -Skeletons=/Game/A/SK_A,/Game/B/SK_B [-IKRigs=/Game/A/IK_A]
+//   [-DataPath=/TTToolbox/Data] [-AddRootBone] [-NoSave]
+//
+// All rows of the data tables are applied. The rows are read through reflection, so the shipped tables based on the Blueprint structures
+// (ST_TT*) as well as tables based on the TTToolbox row structures (FTTNewBone_BP, FTTVirtualBone_BP, ...) are supported.
+// Fields are looked up by their authored name ignoring case, spaces and underscores, a row can either describe a single entry
+// or contain an array of entries. Blend profiles use the row name as blend profile name, unless the entry has a name field.
+// Only the packages of the given skeletons, their skeletal meshes and the ik rigs are saved.
+UCLASS()
+class TTTOOLBOX_API UTTIntegrationCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+public:
+	UTTIntegrationCommandlet();
+
+	int32 Main(const FString& Params) override;
+};
@@ -24,6 +24,23 @@
 #include "Components/PoseableMeshComponent.h"
 #include "TTPoseableMeshComponent.generated.h"
 
+// Local pose of all bones captured by 'UTTPoseableMeshComponent::CapturePose', indexed by bone index. The rotations are stored with the
+// smallest three encoding (the largest component is reconstructed, the other three use 15 bit each and the 2 bit index of the largest component
+// is stored in the remaining bits). The decoded transforms are filled on the first use, so reapplying a pose is a plain copy.
+// Applying a captured pose is lossy, as it always uses the decoded transforms.
+struct CPoseSnapshot
+{
+	int32 Num() const { return Translations.Num(); }
+
+	TWeakObjectPtr<const USkinnedAsset> SkinnedAsset;
+	// three values per bone
+	TArray<uint16> QuantizedRotations;
+	TArray<FVector3f> Translations;
+	TArray<FVector3f> Scales;
+	// decoded transforms, empty until the pose is used the first time and reset whenever the pose is captured
+	TArray<FTransform> DecodedTransforms;
+};
+
 /**
  * 
  */
@@ -35,6 +52,95 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Components|PoseableMesh")
 	void SetBoneLocalTransformByName(const FName& BoneName, const FTransform& InTransform);
 
+	// sets the local transforms of all 'BoneNames' at once, 'BoneNames' and 'Transforms' need to have the same length.
+	// If 'UpdatePoseImmediately' is set to true the pose is updated once afterwards.
+	UFUNCTION(BlueprintCallable, Category = "Components|PoseableMesh")
+	void SetBoneLocalTransformsByName(const TArray<FName>& BoneNames, const TArray<FTransform>& Transforms, bool UpdatePoseImmediately = true);
+
+	// same as 'SetBoneLocalTransformsByName' with bone indices, which can be resolved once via 'GetBoneIndices'.
+	UFUNCTION(BlueprintCallable, Category = "Components|PoseableMesh")
+	void SetBoneLocalTransformsByIndex(const TArray<int32>& BoneIndices, const TArray<FTransform>& Transforms, bool UpdatePoseImmediately = true);
+
+	// returns the bone indices of the 'BoneNames', INDEX_NONE for bones which don't exist.
+	UFUNCTION(BlueprintCallable, Category = "Components|PoseableMesh")
+	TArray<int32> GetBoneIndices(const TArray<FName>& BoneNames);
+
 	UFUNCTION(BlueprintCallable, Category = "Components|PoseableMesh")
 	void UpdatePose();
+
+	// With 'UpdateDirtyBonesOnly' the tick refresh only evaluates the bones changed since the last 'UpdatePose', otherwise all bones are refreshed.
+	// The tick refresh is skipped while a deferred pose update is pending, the deferred update evaluates the pose instead.
+	void RefreshBoneTransforms(FActorComponentTickFunction* TickFunction = nullptr) override;
+
+	// stores the current local transforms of all bones as the pose 'PoseName', an already existing pose with the same name is replaced.
+	UFUNCTION(BlueprintCallable, Category = "Components|PoseableMesh")
+	bool CapturePose(const FName& PoseName);
+
+	// applies the stored pose 'PoseName' to all bones. Returns false if the pose doesn't exist or was captured for another mesh.
+	UFUNCTION(BlueprintCallable, Category = "Components|PoseableMesh")
+	bool ApplyPose(const FName& PoseName, bool UpdatePoseImmediately = true);
+
+	// blends between the stored poses 'PoseNameA' and 'PoseNameB' ('Alpha' = 0 is pose A, 'Alpha' = 1 is pose B) and applies the result to all bones.
+	UFUNCTION(BlueprintCallable, Category = "Components|PoseableMesh")
+	bool BlendPoses(const FName& PoseNameA, const FName& PoseNameB, float Alpha, bool UpdatePoseImmediately = true);
+
+	UFUNCTION(BlueprintCallable, Category = "Components|PoseableMesh")
+	bool HasPose(const FName& PoseName) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Components|PoseableMesh")
+	bool RemovePose(const FName& PoseName);
+
+	UFUNCTION(BlueprintCallable, Category = "Components|PoseableMesh")
+	void ClearPoses();
+
+	// evaluates all deferred pose updates of the 'World' in parallel (all worlds if 'World' is nullptr), called automatically after the actor tick
+	static void FlushPendingPoseUpdates(UWorld* World);
+
+	// drops all deferred pose updates and unregisters from the world delegates, called on module shutdown
+	static void ShutdownPendingPoseUpdates();
+
+public: // members
+	// If set to true 'UpdatePose' and the tick refresh only recompute the component space transforms of the bones which have been changed by the
+	// setters of this component and their children, the tick refresh is skipped if nothing changed. Local transforms changed by other means (e.g. the UPoseableMeshComponent setters) are not detected then.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Components|PoseableMesh")
+	bool UpdateDirtyBonesOnly = false;
+
+	// The bounds are only updated if the accumulated translation of the updated bones since the last bounds update reaches this threshold (cm).
+	// Only used together with 'UpdateDirtyBonesOnly', a full update always updates the bounds.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Components|PoseableMesh", meta = (ClampMin = "0.0"))
+	float BoundsUpdateThreshold = 0.0f;
+
+	// If set to true 'UpdatePose' only requests the update. The component space transforms of all requested components are evaluated in parallel
+	// after the actor tick of the world, only the finalization (buffer flip, child transforms, bounds, render state) runs on the game thread.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Components|PoseableMesh")
+	bool DeferPoseUpdate = false;
+
+private: // methods
+	bool canUpdatePose() const;
+	// fills the component space transforms, only touches the state of this component so it can run on a worker thread
+	void fillPose();
+	// flips the buffers and updates child transforms, bounds and render state, needs to run on the game thread
+	void finalizePose();
+	void markBoneDirty(int32 BoneIndex);
+	// marks the transforms for the tick refresh of the base class, which isn't used with dirty bone tracking
+	void markRefreshTransformDirty();
+	// returns the decoded transforms of the pose 'PoseName', nullptr if the pose can't be applied to the current mesh
+	const TArray<FTransform>* findDecodedPose(const FName& PoseName);
+	void setAllBoneTransforms(bool UpdatePoseImmediately);
+	// recomputes the component space transforms of the dirty bones and their children, returns false if a full fill is needed
+	bool fillDirtyComponentSpaceTransforms(float& OutMaxTranslationDelta);
+	bool canSetBoneTransforms() const;
+
+private: // members
+	// local transforms changed since the last 'UpdatePose', indexed by bone index
+	TBitArray<> m_dirtyBones;
+	bool m_requiresFullFill = true;
+	// accumulated translation of the updated bones since the last bounds update
+	float m_boundsTranslationDelta = 0.0f;
+	// results of the last 'fillPose' used by 'finalizePose'
+	bool m_isFullFill = true;
+	float m_maxTranslationDelta = 0.0f;
+	bool m_isPoseUpdatePending = false;
+
+	TMap<FName, CPoseSnapshot> m_poseSnapshots;
 };
@@ -22,6 +22,9 @@
 
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("TTToolbox"), STATGROUP_TTToolbox, STATCAT_Advanced);
 
 class FTTToolboxModule : public IModuleInterface
 {
@@ -31,6 +31,8 @@ class UIKRigDefinition;
 class UControlRig;
 class UControlRigBlueprint;
 
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FTTOnAnimRecompressionProgress, int32, NumFinished, int32, NumAnimSequences);
+DECLARE_DYNAMIC_DELEGATE_OneParam(FTTOnAnimRecompressionCompleted, int32, NumCompressed);
 
 UCLASS()
 class TTTOOLBOX_API UTTToolboxBlueprintLibrary : public UBlueprintFunctionLibrary
@@ -39,8 +41,10 @@ class TTTOOLBOX_API UTTToolboxBlueprintLibrary : public UBlueprintFunctionLibrar
 public:
 	// virtual bone functions
 
+	// The Dump* functions write the text to the output log and the clipboard. If 'FilePath' is given,
+	// the text is streamed into the file instead, which is recommended for large skeletons.
 	UFUNCTION(BlueprintCallable, Category = "TTToolbox")
-	static bool DumpVirtualBones(USkeleton* Skeleton);
+	static bool DumpVirtualBones(USkeleton* Skeleton, const FString& FilePath = TEXT(""));
 
 	UFUNCTION(BlueprintCallable, Category = "TTToolbox")
 	static bool AddVirtualBone(const FName& VirtualBoneName, const FName& SourceBoneName, const FName& TargetBoneName, USkeleton* Skeleton);
@@ -49,7 +53,7 @@ public:
 	// socket functions
 
 	UFUNCTION(BlueprintCallable, Category = "TTToolbox")
-	static bool DumpSockets(USkeleton* Skeleton);
+	static bool DumpSockets(USkeleton* Skeleton, const FString& FilePath = TEXT(""));
 
 	UFUNCTION(BlueprintCallable, Category = "TTToolbox")
 	static bool AddSocket(const FName& BoneName, const FName& SocketName, const FTransform& RelativeTransform, USkeleton* Skeleton);
@@ -62,18 +66,26 @@ public:
 
 	// dumps all available skeleton curve names to the console and makes them available in the clipboard as well
 	UFUNCTION(BlueprintCallable, Category = "TTToolbox")
-	static bool DumpSkeletonCurveNames(USkeleton* Skeleton);
+	static bool DumpSkeletonCurveNames(USkeleton* Skeleton, const FString& FilePath = TEXT(""));
 
 	// checks if the given 'CurveNamesToCheck' are available in the given 'Skeleton' and prints the missing curves to the console
 	UFUNCTION(BlueprintCallable, Category = "TTToolbox")
 	static bool CheckForMissingCurveNames(const TArray<FName>& CurveNamesToCheck, USkeleton* Skeleton);
 
+	// compares the 'ReferenceCurveNames' with the curves of the 'Skeleton' and returns the missing, extra and common curves.
+	UFUNCTION(BlueprintCallable, Category = "TTToolbox")
+	static FTTCurveDiff_BP DiffSkeletonCurves(const TArray<FName>& ReferenceCurveNames, USkeleton* Skeleton);
+
+	// same as 'DiffSkeletonCurves' for multiple 'Skeletons', returns one diff per valid skeleton.
+	UFUNCTION(BlueprintCallable, Category = "TTToolbox")
+	static TArray<FTTCurveDiff_BP> DiffSkeletonsCurves(const TArray<FName>& ReferenceCurveNames, const TArray<USkeleton*>& Skeletons);
+
 	// returns true if the given 'SkeletonCurveName' exists in the specified 'Skeleton', otherwise false.
 	UFUNCTION(BlueprintCallable, Category = "TTToolbox")
 	static bool HasSkeletonCurve(USkeleton* Skeleton, const FName& SkeletonCurveName);
 
 	UFUNCTION(BlueprintCallable, Category = "TTToolbox")
-	static bool DumpSkeletonBlendProfile(USkeleton* Skeleton);
+	static bool DumpSkeletonBlendProfile(USkeleton* Skeleton, const FString& FilePath = TEXT(""));
 
 	// will add a new 'BlendProfile' to the given 'Skeleton' with the 'BlendProfileName'. If 'Overwrite' is set to true it will overwrite the already existing blend values otherwise returns with false.
 	UFUNCTION(BlueprintCallable, Category = "TTToolbox")
@@ -83,14 +95,36 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "TTToolbox")
 	static bool AddSkeletonCurve(USkeleton* Skeleton, const FName& SkeletonCurveName);
 
+	// adds all 'SkeletonCurves' to the specified 'Skeleton' with a single modification and change notification. The material and morph target
+	// flags are set for new and already existing curves if requested. Returns false if any curve name is invalid, nothing is changed in this case.
+	UFUNCTION(BlueprintCallable, Category = "TTToolbox")
+	static bool AddSkeletonCurves(USkeleton* Skeleton, const TArray<FTTSkeletonCurve_BP>& SkeletonCurves);
+
 	// dumps all groups and montages slots for the given 'Skeleton'. Returns true on success, false otherwise.
 	UFUNCTION(BlueprintCallable, Category = "TTToolbox")
-	static bool DumpGroupsAndSlots(USkeleton* Skeleton);
+	static bool DumpGroupsAndSlots(USkeleton* Skeleton, const FString& FilePath = TEXT(""));
 
 	// adds the given 'SlotGroup' to the specified 'Skeleton'. Returns true on success, false otherwise.
 	UFUNCTION(BlueprintCallable, Category = "TTToolbox")
 	static bool AddSkeletonSlotGroup(USkeleton* Skeleton, const FTTMontageSlotGroup& SlotGroup);
 
+	// Applies all edits of the 'IntegrationProfile' to the 'Skeleton' within a single undo transaction. The profile is validated up front
+	// and nothing is changed if it is invalid, edits that already exist in the 'Skeleton' are skipped unless 'OverwriteExistingEntries' is set.
+	// If 'Save' is set to true the skeleton package is saved once afterwards. Returns true on success, false otherwise.
+	UFUNCTION(BlueprintCallable, Category = "TTToolbox")
+	static bool ApplyIntegrationProfile(USkeleton* Skeleton, const FTTIntegrationProfile& IntegrationProfile, bool Save = false);
+
+	// Writes the virtual bones, sockets, curves, blend profiles and slot groups of the 'Skeleton' and the ik chains of the optional
+	// 'IKRigDefinition' into 'FilePath'. Files ending with ".json" are written as JSON, otherwise a compact versioned binary format is used.
+	UFUNCTION(BlueprintCallable, Category = "TTToolbox")
+	static bool ExportIntegrationSnapshot(USkeleton* Skeleton, UIKRigDefinition* IKRigDefinition, const FString& FilePath);
+
+	// Applies the snapshot stored in 'FilePath' to the 'Skeleton' (see 'ApplyIntegrationProfile') and replaces the ik chains
+	// of the optional 'IKRigDefinition'. Existing sockets, virtual bones, curve flags and blend profiles are overwritten,
+	// so the 'Skeleton' reproduces the snapshot. Returns true on success, false otherwise.
+	UFUNCTION(BlueprintCallable, Category = "TTToolbox")
+	static bool ImportIntegrationSnapshot(USkeleton* Skeleton, UIKRigDefinition* IKRigDefinition, const FString& FilePath, bool Save = false);
+
 	// adds the fiven 'NewBones' to the given 'Skeleton' and it's connected skeletal meshes.
 	// NOTE: Sadly Unreal Engine does come with lot's of assertions and it is very hard to implement this feature in a save way,
 	// the function removes all virtual bones and adds them after again after the unweighted bones are added to the skeletal meshes.
@@ -115,16 +149,31 @@ public:
 
 	// AnimMontage functions
 
-	UFUNCTION(BlueprintCallable, Category = "TTToolbox")
-	static bool CopyAnimMontageCurves(UAnimMontage* SourceAnimMontage, UAnimMontage* TargetAnimMontage);
+	// copies all curves of the 'SourceAnimMontage' to the 'TargetAnimMontage', the keys can be resampled and reduced via the 'CurveCopyOptions'.
+	UFUNCTION(BlueprintCallable, Category = "TTToolbox", meta = (AutoCreateRefTerm = "CurveCopyOptions"))
+	static bool CopyAnimMontageCurves(UAnimMontage* SourceAnimMontage, UAnimMontage* TargetAnimMontage, const FTTCurveCopyOptions& CurveCopyOptions);
+
+	// copies all curves of the 'SourceAnimMontage' to each of the 'TargetAnimMontages'. The curve keys are prepared once per distinct target frame rate
+	// and length and shared between the targets. If 'MergeCurves' is set to true, existing curves of the targets which are not part of the source are kept,
+	// otherwise all existing curves are removed first. Returns false if any target is invalid, the valid targets are processed anyway.
+	UFUNCTION(BlueprintCallable, Category = "TTToolbox", meta = (AutoCreateRefTerm = "CurveCopyOptions"))
+	static bool CopyAnimMontageCurvesToTargets(UAnimMontage* SourceAnimMontage, const TArray<UAnimMontage*>& TargetAnimMontages, const FTTCurveCopyOptions& CurveCopyOptions, bool MergeCurves = false);
 
 	// AnimSequence functions
 
-	// forces animation sequence recompression, which will also reconstraint the virtual bones
+	// forces animation sequence recompression, which will also reconstraint the virtual bones.
+	// Blocks until all animation sequences of the 'Skeleton' are compressed, use 'RequestAnimationRecompressAsync' to keep the editor responsive.
 	UFUNCTION(BlueprintCallable, Category = "TTToolbox")
 	static void RequestAnimationRecompress(USkeleton* Skeleton);
 
+	// Same as 'RequestAnimationRecompress' without blocking, the compressions are requested in the following ticks.
+	// 'OnProgress' is called whenever animation sequences finished their compression and 'OnCompleted' after
+	// all animation sequences of the 'Skeleton' were compressed. Returns false if no compression was requested.
+	UFUNCTION(BlueprintCallable, Category = "TTToolbox", meta = (AutoCreateRefTerm = "OnProgress,OnCompleted"))
+	static bool RequestAnimationRecompressAsync(USkeleton* Skeleton, const FTTOnAnimRecompressionProgress& OnProgress, const FTTOnAnimRecompressionCompleted& OnCompleted);
+
 	// forces animation sequence recompression for the given 'AnimSequences', which will also reconstraint the virtual bones.
+	// Use the latent node 'RequestAnimSequencesRecompressionAsync' to wait for the compressions to finish.
 	UFUNCTION(BlueprintCallable, Category = "TTToolbox")
 	static void RequestAnimSequencesRecompression(TArray<UAnimSequence*> AnimSequences);
 
@@ -135,7 +184,7 @@ public:
 	// IK Rig functions
 
 	UFUNCTION(BlueprintCallable, Category = "TTToolbox")
-  static bool DumpIKChains(const UIKRigDefinition* IKRigDefinition);
+  static bool DumpIKChains(const UIKRigDefinition* IKRigDefinition, const FString& FilePath = TEXT(""));
 
   UFUNCTION(BlueprintCallable, Category = "TTToolbox")
   static bool AddIKBoneChains(UIKRigDefinition* IKRigDefinition, const TArray<FBoneChain_BP>& BoneChains);
@@ -22,15 +22,18 @@
 
 #include "CoreMinimal.h"
 #include "Animation/BlendProfile.h"
+#include "Engine/DataTable.h"
 #include "TTToolboxTypes.generated.h"
 
 // forward declarations
 struct FBoneChain;
+class UAnimSequence;
+class USkeleton;
 
 // Helper stucture that is exposed to Blueprints to be independent from the ik rig implementation.
 // Additionally, this can be reused in data tables to store the bone chains.
 USTRUCT(Blueprintable)
-struct TTTOOLBOX_API FBoneChain_BP
+struct TTTOOLBOX_API FBoneChain_BP : public FTableRowBase
 {
 	GENERATED_BODY()
 
@@ -57,7 +60,7 @@ struct TTTOOLBOX_API FBoneChain_BP
 
 
 USTRUCT(Blueprintable)
-struct TTTOOLBOX_API FTTNewBone_BP
+struct TTTOOLBOX_API FTTNewBone_BP : public FTableRowBase
 {
 	GENERATED_BODY()
 
@@ -93,7 +96,7 @@ struct TTTOOLBOX_API FTTConstraintBones_BP
 };
 
 USTRUCT(Blueprintable)
-struct TTTOOLBOX_API FTTBlendProfile_BP
+struct TTTOOLBOX_API FTTBlendProfile_BP : public FTableRowBase
 {
 	GENERATED_BODY()
 
@@ -105,7 +108,7 @@ struct TTTOOLBOX_API FTTBlendProfile_BP
 };
 
 USTRUCT(Blueprintable)
-struct TTTOOLBOX_API FTTMontageSlotGroup
+struct TTTOOLBOX_API FTTMontageSlotGroup : public FTableRowBase
 {
 	GENERATED_BODY()
 
@@ -116,3 +119,161 @@ struct TTTOOLBOX_API FTTMontageSlotGroup
 	TArray<FName> SlotNames;
 };
 
+USTRUCT(Blueprintable)
+struct TTTOOLBOX_API FTTSkeletonCurve_BP : public FTableRowBase
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TTToolbox")
+	FName CurveName;
+
+	// marks the curve as material curve
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TTToolbox")
+	bool Material = false;
+
+	// marks the curve as morph target curve
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TTToolbox")
+	bool MorphTarget = false;
+};
+
+
+USTRUCT(Blueprintable)
+struct TTTOOLBOX_API FTTVirtualBone_BP : public FTableRowBase
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TTToolbox")
+	FName VirtualBoneName = NAME_None;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TTToolbox")
+	FName SourceBoneName = NAME_None;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TTToolbox")
+	FName TargetBoneName = NAME_None;
+};
+
+USTRUCT(Blueprintable)
+struct TTTOOLBOX_API FTTSocket_BP : public FTableRowBase
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TTToolbox")
+	FName BoneName = NAME_None;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TTToolbox")
+	FName SocketName = NAME_None;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TTToolbox")
+	FTransform RelativeTransform = FTransform::Identity;
+};
+
+// Complete set of skeleton edits of a character integration, which is applied at once by 'ApplyIntegrationProfile'.
+USTRUCT(Blueprintable)
+struct TTTOOLBOX_API FTTIntegrationProfile
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TTToolbox")
+	TArray<FTTVirtualBone_BP> VirtualBones;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TTToolbox")
+	TArray<FTTSocket_BP> Sockets;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TTToolbox")
+	TArray<FTTSkeletonCurve_BP> SkeletonCurves;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TTToolbox")
+	TMap<FName, FTTBlendProfile_BP> BlendProfiles;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TTToolbox")
+	TArray<FTTMontageSlotGroup> SlotGroups;
+
+	// if set to true already existing blend profiles get the values of the profile, otherwise applying the profile fails
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TTToolbox")
+	bool OverwriteBlendProfiles = true;
+
+	// If set to true already existing sockets, virtual bones and curve flags get the values of the profile, otherwise they are kept.
+	// Virtual bones with the same name but other source or target bones are replaced.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TTToolbox")
+	bool OverwriteExistingEntries = false;
+};
+
+// Integration state of a skeleton and its ik rig, which is exported and imported by the snapshot functions.
+USTRUCT(Blueprintable)
+struct TTTOOLBOX_API FTTIntegrationSnapshot
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TTToolbox")
+	FTTIntegrationProfile Profile;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TTToolbox")
+	TArray<FBoneChain_BP> IKBoneChains;
+};
+
+// Difference between a reference list of curve names and the curves of a skeleton.
+USTRUCT(BlueprintType)
+struct TTTOOLBOX_API FTTCurveDiff_BP
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TTToolbox")
+	TObjectPtr<USkeleton> Skeleton = nullptr;
+
+	// reference curves that are missing in the skeleton (in reference order)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TTToolbox")
+	TArray<FName> MissingCurves;
+
+	// skeleton curves that are not part of the reference
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TTToolbox")
+	TArray<FName> ExtraCurves;
+
+	// reference curves that exist in the skeleton (in reference order)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TTToolbox")
+	TArray<FName> CommonCurves;
+};
+
+// Compression report of a single animation sequence.
+USTRUCT(BlueprintType)
+struct TTTOOLBOX_API FTTAnimSequenceCompressionReport_BP
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TTToolbox")
+	TObjectPtr<UAnimSequence> AnimSequence = nullptr;
+
+	// time in seconds from the compression request until the compression was noticed as finished (tick resolution)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TTToolbox")
+	float CompressionTime = 0.f;
+
+	// Heuristic: true if the compression finished synchronously with the request, which is usually a derived data cache hit.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TTToolbox")
+	bool LikelyDDCHit = false;
+
+	// approximated compressed size in bytes before the recompression
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TTToolbox")
+	int64 CompressedSizeBefore = 0;
+
+	// approximated compressed size in bytes after the recompression
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TTToolbox")
+	int64 CompressedSizeAfter = 0;
+};
+
+// Options for copying curve keys between animation assets.
+USTRUCT(BlueprintType)
+struct TTTOOLBOX_API FTTCurveCopyOptions
+{
+	GENERATED_BODY()
+
+	// Samples the source curves once per frame of the target frame rate, e.g. to reduce mocap curves with a key per source frame.
+	// Only curves with more keys than target frames are resampled, the resampled keys are always reduced with the 'ReductionTolerance'.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TTToolbox")
+	bool ResampleToTargetFrameRate = false;
+
+	// removes linear and constant keys which can be reconstructed by their neighbours within the 'ReductionTolerance'
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TTToolbox")
+	bool ReduceKeys = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TTToolbox", meta = (ClampMin = "0.0", EditCondition = "ReduceKeys || ResampleToTargetFrameRate"))
+	float ReductionTolerance = 0.0001f;
+};
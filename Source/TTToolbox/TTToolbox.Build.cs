@@ -64,6 +64,9 @@ public class TTToolbox : ModuleRules
 				"RenderCore",
                 "ControlRig",
                 "ControlRigDeveloper",
+				"UnrealEd",
+				"Json",
+				"JsonUtilities",
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);